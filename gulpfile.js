@@ -10,6 +10,10 @@ let uglify = require('rollup-plugin-uglify');
 let del = require('del');
 let child_process = require('child_process');
 let fs = require('fs');
+let path = require('path');
+let crypto = require('crypto');
+let vm = require('vm');
+let zlib = require('zlib');
 
 const DEST_DEBUG = 'bin-debug/';
 const DEST_RELEASE = 'bin-release/';
@@ -17,12 +21,367 @@ const DEST_RELEASE = 'bin-release/';
 // The jwplayer.js version we are targeting.
 const PLAYER_VERSION = '8.1.3';
 
-function buildTarget(target) {
+// The chunks that are split off app.js, keyed by name (see src/js/utils/chunkloader.js).
+const CHUNKS = {
+    ads: 'src/js/cast/ads/index.js',
+    related: 'src/js/related/index.js'
+};
+
+// The budgets of the release build, per file. Sizes are in bytes, parse times
+// in milliseconds. Release builds fail when app.js exceeds its raw size,
+// `gulp report` fails when any budget is exceeded.
+const BUDGETS = {
+    'app.js': { raw: 72 * 1024, gzip: 24 * 1024, parse: 20 },
+    'chunks/ads.js': { raw: 8 * 1024, gzip: 3 * 1024 },
+    'chunks/related.js': { raw: 8 * 1024, gzip: 3 * 1024 },
+    'css/app.css': { raw: 12 * 1024, gzip: 3 * 1024 },
+    'assets/fonts/jw-icons.woff': { raw: 8 * 1024 }
+};
+
+// The number of hex digits of the content hashes in release file names.
+const HASH_LENGTH = 10;
+
+// The files that get precompressed siblings (.gz and .br) in release builds.
+const COMPRESSIBLE = /\.(html|js|css|json|svg|eot|ttf)$/;
+
+// Returns the value of a command line argument (--name=value).
+function getArg(name) {
+    let prefix = `--${name}=`;
+    let arg = process.argv.find(value => value.indexOf(prefix) === 0);
+    return arg ? arg.slice(prefix.length) : null;
+}
+
+// Bundles an ES module of the app with its imports, so it can be used here.
+function requireModule(entry) {
+    return rollup.rollup({
+        entry: entry
+    }).then((bundle) => {
+        let module = { exports: {} };
+        new Function('module', 'exports', bundle.generate({ format: 'cjs' }).code)(module, module.exports);
+        return module.exports;
+    });
+}
+
+// Compiles the message schema (src/js/cast/messages.js) into the source of
+// the validator functions.
+function compileValidators() {
+    return requireModule('src/js/cast/validatorcompiler.js').then((compiler) => {
+        return `export default (function() {\n${compiler.compileValidators()}\n})();`;
+    });
+}
+
+// Validates config/{appName}/config.json with the rules of the ConfigLoader,
+// and returns the source of the module that builds it into the app.
+function bakeConfig(appName) {
+    const CONFIG = `config/${appName}/config.json`;
+    let config = JSON.parse(fs.readFileSync(CONFIG, 'utf8'));
+    return requireModule('src/js/config/loader.js').then((loader) => {
+        if (!loader.default.validateConfig(config)) {
+            throw new Error('Invalid configuration: ' + CONFIG);
+        }
+        return `export default ${JSON.stringify({
+            appName: appName,
+            config: config,
+            time: Date.now()
+        })};`;
+    });
+}
+
+// Bundles generated sources in place of modules, keyed by their path.
+function replaceModules(sources) {
+    let modules = {};
+    Object.keys(sources).forEach((file) => {
+        modules[path.resolve(file)] = sources[file];
+    });
+    return {
+        load: (id) => modules.hasOwnProperty(id) ? modules[id] : null
+    };
+}
+
+// Bundles a chunk into a script that adds its exports to window.JWCastChunks.
+function buildChunk(name, plugins, dest) {
+    return rollup.rollup({
+        entry: CHUNKS[name],
+        plugins: plugins
+    }).then((bundle) => {
+        let code = bundle.generate({ format: 'cjs' }).code;
+        child_process.execSync('mkdir -p ' + dest + 'chunks/');
+        fs.writeFileSync(`${dest}chunks/${name}.js`, '(function(module) {\nvar exports = module.exports;\n' + code +
+            `\n(window.JWCastChunks = window.JWCastChunks || {})[${JSON.stringify(name)}] = module.exports;\n` +
+            '})({ exports: {} });\n');
+        return bundle.modules;
+    });
+}
+
+// Returns the median time it takes to compile a script, in milliseconds.
+function measureParseTime(code) {
+    let times = [];
+    for (let i = 0; i < 9; i++) {
+        // A unique source, so that the compilation cache is not used.
+        let source = `${code}\n//${i}`;
+        let start = process.hrtime();
+        new vm.Script(source);
+        let time = process.hrtime(start);
+        times.push(time[0] * 1e3 + time[1] / 1e6);
+    }
+    return times.sort((a, b) => a - b)[times.length >> 1];
+}
+
+// Logs the size and the parse time of app.js and the chunks.
+function reportChunks(dest) {
+    let files = ['app.js'].concat(Object.keys(CHUNKS).map(name => `chunks/${name}.js`));
+    files.forEach((file) => {
+        let code = fs.readFileSync(dest + file, 'utf8');
+        console.log('%s: %d bytes, %d gzipped, parsed in %sms', file, Buffer.byteLength(code),
+            zlib.gzipSync(code).length, measureParseTime(code).toFixed(2));
+    });
+}
+
+// Fails when the release app.js exceeds its raw size budget.
+function checkCoreBudget() {
+    let manifest = JSON.parse(fs.readFileSync(DEST_RELEASE + 'manifest.json', 'utf8'));
+    let size = manifest['app.js'].size;
+    let budget = BUDGETS['app.js'].raw;
+    if (size > budget) {
+        throw new Error(`app.js is ${size} bytes, the budget is ${budget} bytes.`);
+    }
+}
+
+// Returns the raw, gzip and brotli sizes of a file's contents.
+function measureSizes(contents) {
+    return {
+        raw: Buffer.byteLength(contents),
+        gzip: zlib.gzipSync(contents, { level: 9 }).length,
+        // Brotli is available from node 11.7 on.
+        brotli: zlib.brotliCompressSync ? zlib.brotliCompressSync(contents).length : null
+    };
+}
+
+// Returns the paths of the files in a directory and its subdirectories.
+function listFiles(dir) {
+    return fs.readdirSync(dir).reduce((files, name) => {
+        let file = path.join(dir, name);
+        return files.concat(fs.statSync(file).isDirectory() ? listFiles(file) : [file]);
+    }, []);
+}
+
+// Installs stub cast and jwplayer globals, so that the scripts can run
+// outside of a receiver. Serialized into the page of measureInChromium().
+function installStubs(playerVersion) {
+    let noop = () => {};
+    let messageBus = { addEventListener: noop, broadcast: noop, send: noop };
+    let receiverManager = {
+        getCastMessageBus: () => messageBus,
+        getSenders: () => [],
+        start: noop,
+        stop: noop
+    };
+    window.cast = {
+        receiver: {
+            CastReceiverManager: { getInstance: () => receiverManager },
+            media: { MEDIA_NAMESPACE: 'urn:x-cast:com.google.cast.media' },
+            logger: { setLevelValue: noop },
+            LoggerLevel: {}
+        }
+    };
+    window.jwplayer = () => ({});
+    window.jwplayer.version = playerVersion;
+    window.jwplayer.utils = { seconds: Number.parseFloat };
+}
+
+// Compiles and runs each script, and writes the median compile time and the
+// run time in milliseconds to #results. Serialized into the page of measureInChromium().
+function measureScripts(scripts) {
+    let results = {};
+    Object.keys(scripts).forEach((file) => {
+        let times = [];
+        let script;
+        for (let i = 0; i < 9; i++) {
+            let start = performance.now();
+            // A unique source, so that the compilation cache is not used.
+            script = new Function(`${scripts[file]}\n//${i}`);
+            times.push(performance.now() - start);
+        }
+        let start = performance.now();
+        try {
+            script();
+            results[file] = { parse: times.sort((a, b) => a - b)[times.length >> 1], run: performance.now() - start };
+        } catch (error) {
+            results[file] = { error: String(error) };
+        }
+    });
+    document.getElementById('results').textContent = JSON.stringify(results);
+}
+
+// Measures the parse and run times of scripts in headless Chromium, keyed by
+// their original name. The browser binary is taken from $CHROME_BIN, and
+// defaults to chromium.
+function measureInChromium(dest, files, manifest) {
+    let scripts = {};
+    files.forEach((file) => {
+        scripts[file] = fs.readFileSync(dest + getHashedName(manifest, file), 'utf8');
+    });
+    let page = dest + 'report.html';
+    fs.writeFileSync(page, '<!doctype html>\n<pre id="results"></pre>\n<script>\n' +
+        `(${installStubs})(${JSON.stringify(PLAYER_VERSION)});\n` +
+        `(${measureScripts})(${JSON.stringify(scripts).replace(/<\//g, '<\\/')});\n</script>\n`);
+    try {
+        let dom = child_process.execFileSync(process.env.CHROME_BIN || 'chromium',
+            ['--headless', '--disable-gpu', '--dump-dom', 'file://' + path.resolve(page)], { encoding: 'utf8' });
+        let results = /<pre id="results">([^<]*)<\/pre>/.exec(dom);
+        return JSON.parse(results[1].replace(/&lt;/g, '<').replace(/&gt;/g, '>').replace(/&amp;/g, '&'));
+    } catch (err) {
+        console.warn('Unable to measure the parse times in headless Chromium: %s', err.message);
+        return {};
+    } finally {
+        fs.unlinkSync(page);
+    }
+}
+
+// Writes the sizes of the release build per file and per bundled module, and
+// the parse times of its scripts to a JSON report. Files are listed by their
+// original name, module sizes are measured before minification.
+// Fails when a budget has been exceeded.
+function writeReport(dest, modulesByFile, out) {
+    let manifest = JSON.parse(fs.readFileSync(dest + 'manifest.json', 'utf8'));
+    let timings = measureInChromium(dest, Object.keys(modulesByFile), manifest);
+    let files = {};
+    ['index.html'].concat(Object.keys(manifest)).forEach((name) => {
+        let file = getHashedName(manifest, name);
+        files[name] = Object.assign({ file: file }, measureSizes(fs.readFileSync(dest + file)), timings[name]);
+        if (modulesByFile[name]) {
+            files[name].modules = modulesByFile[name].map(module => Object.assign({
+                id: path.relative('.', module.id)
+            }, measureSizes(module.code))).sort((a, b) => b.raw - a.raw);
+        }
+    });
+
+    let violations = [];
+    Object.keys(timings).forEach((name) => {
+        if (timings[name].error) {
+            violations.push(`${name} failed to run: ${timings[name].error}`);
+        }
+    });
+    Object.keys(BUDGETS).forEach((name) => {
+        Object.keys(BUDGETS[name]).forEach((metric) => {
+            let value = files[name] ? files[name][metric] : undefined;
+            if (value === undefined) {
+                // Parse times are missing when Chromium is unavailable.
+                if (metric != 'parse') {
+                    violations.push(`${name} ${metric}: missing`);
+                }
+            } else if (value > BUDGETS[name][metric]) {
+                violations.push(`${name} ${metric}: ${value} > ${BUDGETS[name][metric]}`);
+            }
+        });
+    });
+
+    fs.writeFileSync(out, JSON.stringify({
+        version: require('./package.json').version,
+        playerVersion: PLAYER_VERSION,
+        time: new Date().toISOString(),
+        budgets: BUDGETS,
+        violations: violations,
+        files: files
+    }, null, 2));
+    console.log('Report written to %s', out);
+    if (violations.length) {
+        throw new Error('Budgets exceeded:\n' + violations.join('\n'));
+    }
+}
+
+// Returns the name of a file in a build, which is content-hashed in release builds.
+function getHashedName(manifest, name) {
+    return manifest && manifest[name] ? manifest[name].file : name;
+}
+
+// Points the url()s of a stylesheet to the hashed names of the files.
+function rewriteCssUrls(name, css, manifest) {
+    let dir = path.posix.dirname(name);
+    return css.replace(/url\((['"]?)([^'")]+)\1\)/g, (match, quote, url) => {
+        let absolute = url.charAt(0) == '/';
+        let target = absolute ? url.slice(1) : path.posix.join(dir, url);
+        if (!manifest[target]) {
+            return match;
+        }
+        let file = manifest[target].file;
+        return `url(${quote}${absolute ? '/' + file : path.posix.relative(dir, file)}${quote})`;
+    });
+}
+
+// Renames the files of a release build to content-hashed names, so that they
+// can be cached forever, and writes manifest.json which maps the original
+// names to them. Stylesheets are hashed last, after their url()s have been
+// rewritten. The HTML keeps its name.
+function hashAssets(dest) {
+    let manifest = {};
+    let names = listFiles(dest).map(file => path.relative(dest, file).split(path.sep).join('/'))
+        .filter(name => !/\.html$/.test(name) && name != 'manifest.json');
+    let hashFile = (name, contents) => {
+        let hash = crypto.createHash('sha256').update(contents).digest('hex').slice(0, HASH_LENGTH);
+        let ext = path.posix.extname(name);
+        let file = `${name.slice(0, name.length - ext.length)}.${hash}${ext}`;
+        fs.unlinkSync(dest + name);
+        fs.writeFileSync(dest + file, contents);
+        manifest[name] = {
+            file: file,
+            hash: hash,
+            size: contents.length
+        };
+    };
+    names.filter(name => !/\.css$/.test(name)).forEach((name) => {
+        hashFile(name, fs.readFileSync(dest + name));
+    });
+    names.filter(name => /\.css$/.test(name)).forEach((name) => {
+        hashFile(name, Buffer.from(rewriteCssUrls(name, fs.readFileSync(dest + name, 'utf8'), manifest)));
+    });
+    fs.writeFileSync(dest + 'manifest.json', JSON.stringify(manifest, null, 2));
+    return manifest;
+}
+
+// Writes gzip and brotli compressed siblings (.gz and .br) of the text files
+// of a build, so that they don't have to be compressed on every request.
+function precompress(dest) {
+    if (!zlib.brotliCompressSync) {
+        console.warn('Brotli is available from node 11.7 on: Skipping .br files.');
+    }
+    listFiles(dest).filter(file => COMPRESSIBLE.test(file)).forEach((file) => {
+        let contents = fs.readFileSync(file);
+        fs.writeFileSync(file + '.gz', zlib.gzipSync(contents, { level: 9 }));
+        if (zlib.brotliCompressSync) {
+            fs.writeFileSync(file + '.br', zlib.brotliCompressSync(contents));
+        }
+    });
+}
+
+// Renders the HTML, with the hashed names of the files that it loads.
+function renderHtml(dest, useDebugPlayer, manifest) {
+    // The files that are loaded at runtime by their original name.
+    let assets = {};
+    Object.keys(manifest || {}).filter(name => /^(chunks|css\/theme)\//.test(name)).forEach((name) => {
+        assets[name] = manifest[name].file;
+    });
+    return new Promise((resolve, reject) => {
+        gulp.src('./src/*.html')
+            .pipe(mustache({
+                jwplayer: useDebugPlayer ? 'libs/jwplayer.js' : `//ssl.p.jwpcdn.com/player/v/${PLAYER_VERSION}/jwplayer.js`,
+                jwplayerOrigin: useDebugPlayer ? null : 'https://ssl.p.jwpcdn.com',
+                appJs: getHashedName(manifest, 'app.js'),
+                appCss: getHashedName(manifest, 'css/app.css'),
+                assets: JSON.stringify(assets)
+            }))
+            .on('error', reject)
+            .pipe(gulp.dest(dest))
+            .on('finish', resolve);
+    });
+}
+
+function buildTarget(target, appName) {
     const DEST = target == 'debug' ? DEST_DEBUG : DEST_RELEASE;
 
     // Create destination dir if not exists.
     // mkdir -p will create intermediate directories as required.
-    child_process.exec('mkdir -p ' + DEST + 'assets/');
+    child_process.execSync('mkdir -p ' + DEST + 'assets/');
 
     let useDebugPlayer = false;
     if (target === 'debug') {
@@ -42,30 +401,39 @@ function buildTarget(target) {
     }
 
     // Copy assets
-    child_process.exec('cp -r src/assets/* ' + DEST + 'assets/');
-
-    // Render HTML
-    gulp.src('./src/*.html')
-        .pipe(mustache({
-            jwplayer: useDebugPlayer ? 'libs/jwplayer.js' : `//ssl.p.jwpcdn.com/player/v/${PLAYER_VERSION}/jwplayer.js`
-        }))
-        .pipe(gulp.dest(DEST));
+    child_process.execSync('cp -r src/assets/* ' + DEST + 'assets/');
 
     // Render LESS
-    gulp.src('./src/style/**/*.less')
-        .pipe(less({
-            compress: target == 'release'
-        }))
-        .pipe(gulp.dest(DEST + 'css/'));
-
-    // Minify release builds
-    let plugins = [];
-    if (target == 'release') {
-        plugins.push(uglify({}, minifier));
-    }
+    let styles = new Promise((resolve, reject) => {
+        gulp.src('./src/style/**/*.less')
+            .pipe(less({
+                compress: target == 'release'
+            }))
+            .on('error', reject)
+            .pipe(gulp.dest(DEST + 'css/'))
+            .on('finish', resolve);
+    });
 
-    // Rollup JS
-    return rollup.rollup({
+    // Rollup JS, app.js and the chunks that are loaded on demand.
+    let plugins;
+    return Promise.all([
+        compileValidators(),
+        appName ? bakeConfig(appName) : null
+    ]).then((sources) => {
+        let generated = {
+            'src/js/cast/validators.js': sources[0]
+        };
+        if (sources[1]) {
+            generated['src/js/config/bakedconfig.js'] = sources[1];
+        }
+        plugins = [replaceModules(generated)];
+
+        // Minify release builds
+        if (target == 'release') {
+            plugins.push(uglify({}, minifier));
+        }
+
+        return rollup.rollup({
             entry: 'src/js/main.js',
             plugins: plugins,
             globals: {
@@ -73,14 +441,34 @@ function buildTarget(target) {
                 cast: 'cast',
                 google: 'google'
             }
-        }).then((bundle) => {
+        });
+    }).then((bundle) => {
+        let files = ['app.js'].concat(Object.keys(CHUNKS).map(name => `chunks/${name}.js`));
+        return Promise.all([
             bundle.write({
-            //sourceMap: target != 'release',
-            dest: DEST + 'app.js',
-            format: 'iife',
-            moduleName: 'JWCast'
+                //sourceMap: target != 'release',
+                dest: DEST + 'app.js',
+                format: 'iife',
+                moduleName: 'JWCast'
+            }).then(() => bundle.modules)
+        ].concat(Object.keys(CHUNKS).map(name => buildChunk(name, plugins, DEST)), styles)).then((modules) => {
+            reportChunks(DEST);
+            // Release files get content-hashed names, then the HTML is rendered
+            // with those names.
+            let manifest = target == 'release' ? hashAssets(DEST) : null;
+            return renderHtml(DEST, useDebugPlayer, manifest).then(() => {
+                if (manifest) {
+                    precompress(DEST);
+                }
+                // The bundled modules of each script, see writeReport().
+                let modulesByFile = {};
+                files.forEach((file, i) => {
+                    modulesByFile[file] = modules[i];
+                });
+                return modulesByFile;
+            });
         });
-});
+    });
 }
 
 // Serves bin-debug/ and config/ at localhost:8080.
@@ -109,7 +497,25 @@ gulp.task('build', ['clean', 'build:debug', 'build:release']);
 gulp.task('build:debug', ['clean'], () => { return buildTarget('debug') });
 
 // Builds a release package.
-gulp.task('build:release', ['clean'], () => { return buildTarget('release') });
+gulp.task('build:release', ['clean'], () => { return buildTarget('release').then(checkCoreBudget) });
+
+// Builds a release package with the config of an app built in:
+// gulp build:app --appName={directoryName}
+gulp.task('build:app', ['clean'], () => {
+    let appName = getArg('appName');
+    if (!appName) {
+        throw new Error('Usage: gulp build:app --appName={directoryName}');
+    }
+    return buildTarget('release', appName).then(checkCoreBudget);
+});
+
+// Builds a release package, and writes a JSON report of its sizes and parse
+// times that fails when a budget is exceeded:
+// gulp report [--out={file}]
+gulp.task('report', ['clean'], () => {
+    let out = getArg('out') || DEST_RELEASE + 'report.json';
+    return buildTarget('release').then(modules => writeReport(DEST_RELEASE, modules, out));
+});
 
 // Development task: serves bin-debug and watches for changes.
 gulp.task('dev', ['watch', 'serve']);
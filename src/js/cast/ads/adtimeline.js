@@ -0,0 +1,188 @@
+import AdBreakInfo from './adbreakinfo';
+
+/**
+ * Parses a schedule offset ('pre', 'post', 'hh:mm:ss', 'NN%' or seconds).
+ * Returns the position in seconds, or a function that resolves the
+ * position for a given duration.
+ */
+function parseOffset(offset) {
+    offset = String(offset);
+    if (offset == 'pre') {
+        return 0;
+    }
+    if (offset == 'post') {
+        return duration => duration;
+    }
+    if (offset.slice(-1) === '%') {
+        let percentage = Number.parseFloat(offset.slice(0, -1));
+        return duration => duration * percentage / 100;
+    }
+    return offset.indexOf(':') != -1 ?
+        jwplayer.utils.seconds(offset) : Number.parseFloat(offset);
+}
+
+/**
+ * Returns the position of a scheduled break, using the offset that has been
+ * parsed when the request was validated, if any.
+ */
+function getPosition(scheduledBreak) {
+    let parsedOffset = scheduledBreak.parsedOffset;
+    if (!parsedOffset) {
+        return parseOffset(scheduledBreak.offset);
+    }
+    if (parsedOffset.fraction !== undefined) {
+        return duration => duration * parsedOffset.fraction;
+    }
+    return parsedOffset.position;
+}
+
+function compareBreaks(a, b) {
+    return a.position - b.position;
+}
+
+/**
+ * The ad breaks and break clips of a media item.
+ *
+ * The advertising schedule is parsed once, when the item is loaded.
+ * Breaks with an offset relative to the duration ('post' and 'NN%') are
+ * added once the duration is known.
+ * Breaks can be looked up by id and by ad tag, clips by id.
+ *
+ * @param {Object} schedule The advertising schedule (customData.advertising.schedule).
+ */
+export default class AdTimeline {
+
+    constructor(schedule) {
+        // The breaks, sorted by position.
+        this.breaks = [];
+        this.clips = [];
+        this.breaksById = new Map();
+        this.breakIdsByTag = new Map();
+        this.clipsById = new Map();
+        // Breaks that can't be positioned until the duration is known.
+        this.pending = [];
+        this.indexedSchedule = null;
+        this.duration = undefined;
+
+        if (schedule) {
+            Object.keys(schedule).forEach(breakId => {
+                let scheduledBreak = schedule[breakId];
+                let position = getPosition(scheduledBreak);
+                if (typeof (position) === 'function') {
+                    this.pending.push({
+                        breakId: breakId,
+                        resolve: position
+                    });
+                } else {
+                    this.addBreak(new AdBreakInfo(breakId, position));
+                }
+                this.indexTag(scheduledBreak.tag, breakId);
+            });
+            this.breaks.sort(compareBreaks);
+        }
+    }
+
+    /**
+     * Whether the item has a break at position 0.
+     */
+    get hasPreRoll() {
+        return this.breaks.length > 0 && this.breaks[0].position === 0;
+    }
+
+    /**
+     * Sets the duration of the item and positions the breaks that depend on it.
+     *
+     * @return {boolean} Whether the breaks have been changed.
+     */
+    setDuration(duration) {
+        if (!(duration > 0) || duration === this.duration || !this.pending.length) {
+            return false;
+        }
+        this.duration = duration;
+        this.pending.forEach(pendingBreak => {
+            let adBreak = this.breaksById.get(pendingBreak.breakId);
+            if (adBreak) {
+                adBreak.position = pendingBreak.resolve(duration);
+            } else {
+                this.addBreak(new AdBreakInfo(pendingBreak.breakId, pendingBreak.resolve(duration)));
+            }
+        });
+        this.breaks.sort(compareBreaks);
+        return true;
+    }
+
+    /**
+     * Adds the tags of a schedule (e.g. the adschedule of a playlist item)
+     * to the tag index. Indexing the same schedule again is a no-op.
+     */
+    indexTags(schedule) {
+        if (schedule && schedule !== this.indexedSchedule) {
+            this.indexedSchedule = schedule;
+            Object.keys(schedule).forEach(breakId => {
+                this.indexTag(schedule[breakId].tag, breakId);
+            });
+        }
+    }
+
+    /**
+     * Returns the breakId of the break that uses the given ad tag, or null.
+     */
+    getBreakIdByTag(tag) {
+        let breakId = this.breakIdsByTag.get(tag);
+        return breakId !== undefined ? breakId : null;
+    }
+
+    /**
+     * Returns the break with the given id, or null.
+     */
+    getBreak(breakId) {
+        return this.breaksById.get(breakId) || null;
+    }
+
+    /**
+     * Adds a clip to the timeline, as part of the break with the given id.
+     */
+    addClip(clip, breakId) {
+        let adBreak = this.getBreak(breakId);
+        this.clips.push(clip);
+        this.clipsById.set(clip.id, {
+            clip: clip,
+            adBreak: adBreak
+        });
+        if (adBreak) {
+            adBreak.breakClipIds = adBreak.breakClipIds || [];
+            adBreak.breakClipIds.push(clip.id);
+        }
+    }
+
+    /**
+     * Returns the clip with the given id, or null.
+     */
+    getClip(clipId) {
+        let entry = this.clipsById.get(clipId);
+        return entry ? entry.clip : null;
+    }
+
+    /**
+     * Returns the break that contains the clip with the given id, or null.
+     */
+    getBreakOfClip(clipId) {
+        let entry = this.clipsById.get(clipId);
+        return entry ? entry.adBreak : null;
+    }
+
+    addBreak(adBreak) {
+        this.breaks.push(adBreak);
+        this.breaksById.set(adBreak.id, adBreak);
+    }
+
+    indexTag(tag, breakId) {
+        if (Array.isArray(tag)) {
+            // A waterfall of tags.
+            tag.forEach(waterfallTag => this.indexTag(waterfallTag, breakId));
+        } else if (tag && !this.breakIdsByTag.has(tag)) {
+            this.breakIdsByTag.set(tag, breakId);
+        }
+    }
+
+}
@@ -0,0 +1,11 @@
+import AdBreakClipInfo from './adbreakclipinfo';
+import AdBreakStatus from './adbreakstatus';
+import AdCompanion from './adcompanion';
+import AdMeta from './admeta';
+import AdTimeline from './adtimeline';
+
+/**
+ * The ads chunk. The build splits it off app.js (see gulpfile.js), the
+ * media manager loads it the first time an item with ads is loaded.
+ */
+export { AdBreakClipInfo, AdBreakStatus, AdCompanion, AdMeta, AdTimeline };
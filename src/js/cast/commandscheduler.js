@@ -0,0 +1,160 @@
+/**
+ * The classes of commands, in order of priority.
+ *
+ * @readonly
+ * @enum {string}
+ */
+export const CommandClass = {
+    /**
+     * Cheap commands the user is waiting for, e.g. PAUSE. Executed right away,
+     * after the queue commands that arrived before them.
+     */
+    TRANSPORT: 'transport',
+    /**
+     * Commands that load items or edit the queue.
+     */
+    QUEUE: 'queue',
+    /**
+     * Commands that only read state, e.g. GET_STATUS.
+     */
+    POLL: 'poll'
+};
+
+/**
+ * The order in which queued commands are executed.
+ */
+const QUEUED_CLASSES = [CommandClass.QUEUE, CommandClass.POLL];
+
+/**
+ * The time in milliseconds queued commands may run for before the
+ * scheduler yields to other tasks, e.g. incoming messages.
+ */
+export const TIME_SLICE = 8;
+
+/**
+ * Executes commands in order of priority.
+ *
+ * Transport commands are executed right away, other commands are queued
+ * per class and executed in a later task, so that transport commands that
+ * arrive in the meantime jump ahead of polls. Queue commands keep their
+ * order with transport commands, a transport command first executes the
+ * queue commands that arrived before it, as these can change the item it
+ * applies to. Queued commands are executed in slices of TIME_SLICE
+ * milliseconds, between which the scheduler yields.
+ *
+ * Example Usage:
+ *
+ * let scheduler = new CommandScheduler();
+ * scheduler.schedule(CommandClass.QUEUE, () => onQueueInsert(event));
+ */
+export default class CommandScheduler {
+
+    constructor() {
+        this.queues = {};
+        this.stats = {};
+        Object.keys(CommandClass).forEach(key => {
+            let commandClass = CommandClass[key];
+            this.queues[commandClass] = [];
+            this.stats[commandClass] = {
+                commands: 0,
+                totalDelay: 0,
+                maxDelay: 0
+            };
+        });
+        this.timeoutId = -1;
+        this.drain = this.drain.bind(this);
+    }
+
+    /**
+     * Executes a command, or queues it.
+     *
+     * @param {CommandClass} commandClass The class of the command.
+     * @param {function()} command The command.
+     */
+    schedule(commandClass, command) {
+        if (commandClass == CommandClass.TRANSPORT) {
+            // Queue commands that arrived earlier can change the current
+            // item, the transport command has to apply to that item.
+            this.flush(CommandClass.QUEUE);
+            this.execute(commandClass, command, Date.now());
+            return;
+        }
+        this.queues[commandClass].push({
+            command: command,
+            time: Date.now()
+        });
+        if (this.timeoutId == -1) {
+            this.timeoutId = setTimeout(this.drain, 0);
+        }
+    }
+
+    /**
+     * Executes queued commands until the time slice is used up.
+     */
+    drain() {
+        this.timeoutId = -1;
+        let start = Date.now();
+        let entry;
+        while ((entry = this.next())) {
+            this.execute(entry.commandClass, entry.command, entry.time);
+            if (Date.now() - start >= TIME_SLICE) {
+                break;
+            }
+        }
+        if (this.next(true) && this.timeoutId == -1) {
+            this.timeoutId = setTimeout(this.drain, 0);
+        }
+    }
+
+    /**
+     * Executes the queued commands of a class right away.
+     *
+     * @param {CommandClass} commandClass The class of the commands.
+     */
+    flush(commandClass) {
+        let queue = this.queues[commandClass];
+        while (queue.length) {
+            let entry = queue.shift();
+            this.execute(commandClass, entry.command, entry.time);
+        }
+    }
+
+    /**
+     * Takes the next queued command out of the queues.
+     *
+     * @param {boolean} peek Whether to leave the command in its queue.
+     */
+    next(peek) {
+        for (let i = 0; i < QUEUED_CLASSES.length; i++) {
+            let queue = this.queues[QUEUED_CLASSES[i]];
+            if (queue.length) {
+                let entry = peek ? queue[0] : queue.shift();
+                entry.commandClass = QUEUED_CLASSES[i];
+                return entry;
+            }
+        }
+        return null;
+    }
+
+    execute(commandClass, command, time) {
+        let delay = Date.now() - time;
+        let stats = this.stats[commandClass];
+        stats.commands++;
+        stats.totalDelay += delay;
+        stats.maxDelay = Math.max(stats.maxDelay, delay);
+        try {
+            command();
+        } catch (err) {
+            console.warn('Unable to execute command: %O', err);
+        }
+    }
+
+    /**
+     * Returns the number of commands and their total and maximum queueing
+     * delay in milliseconds, per class.
+     */
+    getStats() {
+        return JSON.parse(JSON.stringify(this.stats));
+    }
+
+}
@@ -3,13 +3,19 @@ import * as Events from '../events';
 import { PlayerState } from './playerstate';
 import { RepeatMode } from './repeatmode';
 import { Command } from './command';
-import { EventType, MessageType, ErrorReason, SeekResumeState, IdleReason } from './messages';
+import { EventType, MessageType, ErrorReason, SeekResumeState, IdleReason,
+    QueueChangeType, GetStatusOptions } from './messages';
 import { TrackType, TextTrackType } from './tracktype';
-import AdBreakInfo from './ads/adbreakinfo';
-import AdBreakClipInfo from './ads/adbreakclipinfo';
-import AdBreakStatus from './ads/adbreakstatus';
-import AdMeta from './ads/admeta';
-import AdCompanion from './ads/adcompanion';
+import MediaQueue from './mediaqueue';
+import ListenerRegistry from '../utils/listenerregistry';
+import TimePipeline from './timepipeline';
+import PendingRequests, { Completion } from './pendingrequests';
+import RequestCache from './requestcache';
+import SenderLimiter from './senderlimiter';
+import CommandScheduler, { CommandClass } from './commandscheduler';
+import validators from './validators';
+import TrackRegistry from './trackregistry';
+import ChunkLoader from '../utils/chunkloader';
 
 /**
  * Supported features of this {@link MediaManager}.
@@ -28,15 +34,23 @@ const SUPPORTED_FEATURES = Command.ALL_BASIC_MEDIA
  * Flags which are being used when serializing the mediaStatus.
  *
  * These flags have to be set in order to serialize certain elements of
- * the mediaStatus.
+ * the mediaStatus. Note that META also covers the ad timeline, since
+ * breaks and breakClips live in mediaStatus.media.
  *
  * @readonly
  * @enum {string}
  */
-// export const MediaStatusFlags = {
-//   QUEUE: 'items'
-//   META: 'media'
-// };
+export const MediaStatusFlags = {
+    QUEUE: 'items',
+    META: 'media'
+};
+
+/**
+ * All elements of the media status that are only serialized when flagged.
+ *
+ * @readonly
+ */
+const ALL_STATUS_ELEMENTS = [MediaStatusFlags.QUEUE, MediaStatusFlags.META];
 
 /**
  * Track index 0 always disables a track on the JW Player.
@@ -47,6 +61,86 @@ const TRACK_DISABLED = 0;
 
 export const ERROR_TIMEOUT = 5000;
 
+/**
+ * The maximum number of items a sender can fetch with a single QUEUE_GET_ITEMS request.
+ */
+export const MAX_QUEUE_ITEMS_PER_REQUEST = 20;
+
+/**
+ * The maximum size of the serialized queue items in a MEDIA_STATUS message.
+ * Larger queues are left out, senders can fetch them using QUEUE_GET_ITEM_IDS
+ * and QUEUE_GET_ITEMS instead. Cast messages are limited to 64KB.
+ */
+export const MAX_STATUS_QUEUE_SIZE = 32 * 1024;
+
+/**
+ * The number of seconds before the end of the current item at which the next
+ * item in the queue will be preloaded, unless the item specifies a preloadTime.
+ */
+export const DEFAULT_PRELOAD_TIME = 20;
+
+/**
+ * The element id of the active player, and of the player that preloads items.
+ */
+export const PLAYER_ELEMENT_ID = 'player';
+export const STANDBY_PLAYER_ELEMENT_ID = 'player-standby';
+
+/**
+ * Commands that only read state. These are executed again when they are
+ * retried, instead of being answered from the request cache.
+ */
+const READ_ONLY_EVENTS = [
+    EventType.GET_STATUS,
+    EventType.QUEUE_GET_ITEM_IDS,
+    EventType.QUEUE_GET_ITEMS,
+    EventType.QUEUE_GET_ITEM_RANGE
+];
+
+/**
+ * Requests for pages of the queue. These are exempt from the sender rate
+ * limit, a sender needs every page to show a long queue.
+ */
+const QUEUE_PAGING_EVENTS = [
+    EventType.QUEUE_GET_ITEM_IDS,
+    EventType.QUEUE_GET_ITEMS,
+    EventType.QUEUE_GET_ITEM_RANGE
+];
+
+/**
+ * Commands that are executed right away, after the queue edits that arrived
+ * before them and ahead of polls.
+ */
+const TRANSPORT_EVENTS = [
+    EventType.PAUSE,
+    EventType.PLAY,
+    EventType.SEEK,
+    EventType.STOP,
+    EventType.SET_VOLUME
+];
+
+/**
+ * The time in milliseconds a LOAD or QUEUE_LOAD that cancels another load waits
+ * before it starts, so that a burst of loads only sets up the last one.
+ */
+export const LOAD_COALESCE_WINDOW = 200;
+
+/**
+ * The time in milliseconds after which a seek is considered done, in case
+ * the player does not report it.
+ */
+export const SEEK_TIMEOUT = 3000;
+
+/**
+ * The minimum time in milliseconds between two USER_ACTIVITY events.
+ */
+export const USER_ACTIVITY_INTERVAL = 1000;
+
+/**
+ * The time in milliseconds a status serialized for a GET_STATUS request is
+ * reused for other GET_STATUS requests, unless the status changes.
+ */
+export const STATUS_COLLAPSE_WINDOW = 100;
+
 /**
  * A cast.receiver.media.MediaManager implementation for JW Player.
  *
@@ -55,50 +149,166 @@ export const ERROR_TIMEOUT = 5000;
  *
  * @param {cast.receiver.ReceiverManager} receiverManager The ReceiverManager singleton.
  * @param {HTMLElement} container the container jwplayer.js can be attached to.
+ * @param {MessageBuffer=} messageBus The media message bus, if it has been
+ * wrapped in a MessageBuffer.
  */
-export default function JWMediaManager(receiverManager, container, events, analyticsConfig) {
+export default function JWMediaManager(receiverManager, container, events, analyticsConfig, config, messageBus) {
 
     // The current JW Player instance.
-    // TODO: make this an object, which allows for multiple playerInstances per mediaSessionId
-    // so we can do preloading.
     let playerInstance;
 
+    // Owns every listener that has been added to playerInstance for the
+    // item that is currently loaded, so they can be removed as a unit.
+    let playerListeners = null;
+
+    // Distributes the playback position to the UI.
+    let timePipeline = new TimePipeline(events, config);
+
+    // A hidden JW Player instance that preloads the next item, which is swapped
+    // in when that item gets loaded.
+    // Contains the player and the item it has been set up for.
+    let standby = null;
+
+    // The element players are attached to, jwplayer.js replaces the
+    // container elements on setup.
+    let playerParent = container.parentNode;
+
+    // Identifies the parts of the config the active player has been set up with
+    // that can't be changed by loading a new playlist.
+    let playerConfigKey = null;
+
+    // Time to first frame per load path: a full 'setup', a 'load' on the
+    // active player or a swap to the 'preload'ed player.
+    let loadStats = {};
+
     // Represents the status of a media session.
     let mediaStatus;
 
+    // The queue of the media session, serialized as mediaStatus.items.
+    let queue;
+
     /**
      * By default we do not serialize the entire media status.
      * The following elements should be set in this block if they
      * should be serialized.
      *
-     * This object is used to set the flags for which elements in the media
-     * status should be serialized.
+     * This array is used to set the flags for which elements in the media
+     * status should be serialized with the next broadcast.
      */
-        // let mediaStatusFlags = [];
+    let mediaStatusFlags = [];
+
+    // Version of the flagged elements of the media status, increased whenever
+    // one of them changes. Senders can pass it back in GET_STATUS to avoid
+    // receiving elements they already have.
+    let mediaStatusVersion = 0;
+
+    // Revisions of the flagged elements of the media status, increased by every
+    // mutation point. Used to invalidate the serialized fragments below.
+    let fragmentRevisions = {};
+
+    // Serialized JSON of the flagged elements, keyed by element name.
+    // These make up most of the bytes of a status message, but rarely change.
+    let fragmentCache = {};
 
-        // The messageBus used for sending/receiving messages.
-    let messageBus = receiverManager.getCastMessageBus(cast.receiver.media.MEDIA_NAMESPACE);
+    // The messageBus used for sending/receiving messages.
+    messageBus = messageBus || receiverManager.getCastMessageBus(cast.receiver.media.MEDIA_NAMESPACE);
 
-    // The requestId that will be associated with the next status update.
+    // The requests that have not been acknowledged with a status update yet.
     // So that senders can correlate their actions with a status update.
-    let currentRequestId = 0;
+    let pendingRequests = new PendingRequests();
+
+    // Whether requests that complete at the same time are acknowledged in a
+    // single status update (with a completedRequestIds list), instead of a
+    // status update per request.
+    let mergeCompletedRequests = !!(config && config.mergeCompletedRequests);
+
+    // The maximum size of the serialized queue items in a MEDIA_STATUS message.
+    let maxStatusQueueSize = config && typeof config.maxStatusQueueSize === 'number'
+        ? config.maxStatusQueueSize : MAX_STATUS_QUEUE_SIZE;
+
+    // Recent requests per sender and their replies, for answering retries.
+    let requestCache = new RequestCache();
+
+    // Limits the rate of requests per sender, and counts them.
+    let senderLimiter = new SenderLimiter(config ? config.senderRateLimit : undefined);
+
+    // Executes commands in order of priority.
+    let commandScheduler = new CommandScheduler();
+
+    // The last time USER_ACTIVITY has been published.
+    let lastActivityTime = -Infinity;
+
+    // Statuses serialized for GET_STATUS requests, keyed by the requested
+    // elements. Dropped whenever the status changes.
+    let statusSnapshots = {};
 
     // Whether we are currently processing a load request.
     let isLoading = false;
 
+    // The LOAD or QUEUE_LOAD request that is being loaded.
+    let loadingEvent = null;
+
+    // A LOAD or QUEUE_LOAD request that waits for the end of a burst of loads.
+    let deferredLoad = null;
+
+    // The loadItem() call in progress, which can be cancelled.
+    let currentLoad = null;
+
+    // Whether the player is seeking on our behalf. SEEK requests that arrive
+    // in the meantime only update queuedSeekTime, the latest target.
+    let seekInFlight = false;
+    let queuedSeekTime = -1;
+    let seekTimeoutId = -1;
+
+    // When the current burst of seeks started, and whether we are waiting
+    // for playback to resume after it, to measure the seek-to-playing latency.
+    let scrubStartTime = 0;
+    let awaitingPlayback = false;
+
+    let seekStats = {
+        requests: 0,
+        applied: 0,
+        scrubs: 0,
+        totalLatency: 0,
+        lastLatency: 0
+    };
+
     // The last time an ad pod was initiated.
     let adPodStartTime = 0;
 
+    // The exports of the ads chunk (see cast/ads/index.js), which is loaded
+    // the first time an item with ads is loaded.
+    let ads = null;
+
+    // The ad breaks and break clips of the current item, if it has ads.
+    let adTimeline = null;
+
+    // The tracks of the current item, and the ones that are active.
+    let trackRegistry = new TrackRegistry();
+
+    // Whether a status broadcast has been scheduled, but has not been sent yet.
+    // Every broadcastStatus() call made in the same task is merged into it.
+    let pendingBroadcast = false;
+
+    // Counters that show how many status broadcasts have been merged, and
+    // how many acknowledgements have been sent along with them.
+    let broadcastStats = {
+        requested: 0,
+        sent: 0,
+        coalesced: 0,
+        acknowledgements: 0
+    };
+
     // Start listening for messages.
     messageBus.addEventListener('message', dispatchEvent);
 
     /**
      * Broadcasts a message to every connected sender.
-     * @param  {Object} message The message to send to senders.
+     * @param  {Object|string} message The message to send to senders, or its JSON.
      */
     function broadcastMessage(message) {
         try {
-            messageBus.broadcast(JSON.stringify(message));
+            messageBus.broadcast(typeof message === 'string' ? message : JSON.stringify(message));
         } catch (err) {
             console.warn('Unable to broadcast message: %O', err);
         }
@@ -107,11 +317,11 @@ export default function JWMediaManager(receiverManager, container, events, analy
     /**
      * Sends a message to a specific sender.
      * @param  {string} senderId The identifier of the sender to send a message to.
-     * @param  {Object} message  The message to send.
+     * @param  {Object|string} message  The message to send, or its JSON.
      */
     function sendMessage(senderId, message) {
         try {
-            messageBus.send(senderId, JSON.stringify(message));
+            messageBus.send(senderId, typeof message === 'string' ? message : JSON.stringify(message));
         } catch (err) {
             console.warn('Unable to send message: %O', err);
         }
@@ -119,7 +329,8 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
     /**
      * Dispatches a message to the message handler for a specific event.
-     * Also does validation of messages.
+     * Also does validation of messages. The handler is executed by the
+     * commandScheduler, transport commands are executed right away.
      *
      * @param  {Object} message The message to dispatch.
      */
@@ -137,28 +348,74 @@ export default function JWMediaManager(receiverManager, container, events, analy
             return;
         }
 
+        let event = {
+            senderId: message.senderId,
+            data: data,
+            type: data.type
+        };
+
         if (!data.type) {
             // err: invalid request.
             sendErrorInvalidRequest(event, ErrorReason.INVALID_COMMAND);
             return;
         }
 
-        let event = {
-            senderId: message.senderId,
-            data: data,
-            type: data.type
-        };
+        // Requests of senders that are over their limit are still answered,
+        // but their status polls get the last serialized status, however old.
+        let withinLimit = true;
+        if (QUEUE_PAGING_EVENTS.indexOf(event.type) >= 0) {
+            senderLimiter.count(event.senderId, 'requests');
+        } else {
+            withinLimit = senderLimiter.take(event.senderId);
+        }
+        event.limited = !withinLimit;
+
+        // Reject malformed requests before they get to a handler, the
+        // validators also normalize the parameters.
+        let validator = validators[event.type];
+        let invalidField = validator ? validator(data) : null;
+        if (invalidField) {
+            console.warn('Invalid %s request, %s is invalid', event.type, invalidField);
+            sendErrorInvalidRequest(event, ErrorReason.INVALID_PARAMS);
+            return;
+        }
+
+        // Senders retry requests that did not get a timely reply, these
+        // should not be executed again.
+        if (answerRetry(event)) {
+            return;
+        }
 
         // Broadcast that user activity has occured so that the UI
         // can be updated appropriately.
-        // TODO: we might want to limit USER_ACTIVITY to a subset of
-        // events.
-        if (event.type != EventType.GET_STATUS) {
-            events.publish(Events.USER_ACTIVITY, {
-                reason: event.type
-            });
+        if (withinLimit && event.type != EventType.GET_STATUS) {
+            publishUserActivity(event.type);
+        }
+
+        let commandClass = CommandClass.QUEUE;
+        if (TRANSPORT_EVENTS.indexOf(event.type) >= 0) {
+            commandClass = CommandClass.TRANSPORT;
+        } else if (READ_ONLY_EVENTS.indexOf(event.type) >= 0) {
+            commandClass = CommandClass.POLL;
         }
+        commandScheduler.schedule(commandClass, () => {
+            try {
+                executeEvent(event);
+            } catch (err) {
+                // The request will not be answered, let a retry execute it.
+                pendingRequests.remove(event.senderId, event.data.requestId);
+                requestCache.forget(event.senderId, event.data.requestId);
+                throw err;
+            }
+        });
+    }
 
+    /**
+     * Executes a request that has been dispatched.
+     *
+     * @param  {Object} event The request.
+     */
+    function executeEvent(event) {
         // First see if we need to handle any events that create
         // mediaSessions, or don't need one to be handled.
         switch (event.type) {
@@ -178,17 +435,28 @@ export default function JWMediaManager(receiverManager, container, events, analy
         // We're handling an event that doesn't create a media session
         // first, let's do some validation before we dispatch anything.
         if (!mediaStatus) {
+            requestCache.forget(event.senderId, event.data.requestId);
             sendErrorInvalidPlayerState(event);
             return;
         }
         if (event.data.mediaSessionId != mediaStatus.mediaSessionId) {
             // err: wrong mediaSession
-            // We don't have to do anything in this case.
+            // We don't have to do anything in this case, besides letting a
+            // retry with the right mediaSessionId through.
+            requestCache.forget(event.senderId, event.data.requestId);
             return;
         }
 
-        if (event.data.requestId) {
-            currentRequestId = event.data.requestId;
+        // Reads are answered directly, only commands are acknowledged by
+        // a status broadcast.
+        let isCommand = READ_ONLY_EVENTS.indexOf(event.type) < 0;
+        if (isCommand) {
+            pendingRequests.add(event.senderId, event.data.requestId);
+            // Transport commands that follow a change of the current item
+            // apply to the new item, acknowledge them after that change.
+            if (TRANSPORT_EVENTS.indexOf(event.type) >= 0 && pendingRequests.isWaiting(Completion.LOADED)) {
+                pendingRequests.defer(event.senderId, event.data.requestId, Completion.LOADED);
+            }
         }
 
         // Message looks good so far, proceed with dispatching it.
@@ -223,6 +491,15 @@ export default function JWMediaManager(receiverManager, container, events, analy
             case EventType.QUEUE_REORDER:
                 onQueueReorder(event);
                 break;
+            case EventType.QUEUE_GET_ITEM_IDS:
+                onQueueGetItemIds(event);
+                break;
+            case EventType.QUEUE_GET_ITEMS:
+                onQueueGetItems(event);
+                break;
+            case EventType.QUEUE_GET_ITEM_RANGE:
+                onQueueGetItemRange(event);
+                break;
             case EventType.PRELOAD:
                 onPreload(event);
                 break;
@@ -235,6 +512,57 @@ export default function JWMediaManager(receiverManager, container, events, analy
                     ErrorReason.INVALID_COMMAND, event);
                 console.warn('Received invalid command ' + event.type);
         }
+
+        // Acknowledge the request with the next status update, unless
+        // it has been deferred or resulted in an error.
+        if (isCommand) {
+            pendingRequests.settle(event.senderId, event.data.requestId);
+        }
+    }
+
+    /**
+     * Publishes USER_ACTIVITY, at most once per USER_ACTIVITY_INTERVAL.
+     * Its subscribers only restart inactivity timers, which are much longer.
+     */
+    function publishUserActivity(reason) {
+        let now = Date.now();
+        if (now - lastActivityTime < USER_ACTIVITY_INTERVAL) {
+            return;
+        }
+        lastActivityTime = now;
+        events.publish(Events.USER_ACTIVITY, {
+            reason: reason
+        });
+    }
+
+    /**
+     * Answers a request that has been seen before, with the reply it got,
+     * or with DUPLICATE_REQUEST_ID if it is still in flight.
+     * Other requests are added to the request cache.
+     *
+     * @param  {Object} event The request.
+     * @return {boolean} Whether the request was a retry.
+     */
+    function answerRetry(event) {
+        let requestId = event.data.requestId;
+        if (!requestId || READ_ONLY_EVENTS.indexOf(event.type) >= 0) {
+            return false;
+        }
+        let entry = requestCache.lookup(event.senderId, requestId);
+        if (!entry) {
+            requestCache.add(event.senderId, requestId);
+            return false;
+        }
+        if (entry.reply !== null) {
+            sendMessage(event.senderId, entry.reply);
+        } else {
+            sendMessage(event.senderId, {
+                type: MessageType.INVALID_REQUEST,
+                requestId: requestId,
+                reason: ErrorReason.DUPLICATE_REQUEST_ID
+            });
+        }
+        return true;
     }
 
     /*
@@ -245,20 +573,13 @@ export default function JWMediaManager(receiverManager, container, events, analy
         // TODO: Handle load requests where the actual media
         // doesn't change, but only it's metadata, for example
         // images. Currently we don't handle these well, but we
-        if (isLoading) {
-            // Send load cancelled.
-            sendErrorLoadCancelled(event);
-        }
-        createMediaSession();
-        loadItem(event.data).then(() => {
-            isLoading = false;
-            sendStatus(event.senderId, event.data.requestId);
-        }, (error) => {
-            currentRequestId = event.data.requestId;
-            handleSetupError(error);
-        });
-        events.publish(Events.QUEUE_LOAD, {
-            items: [event.data]
+        requestLoad(event, () => {
+            createMediaSession();
+            let loading = loadItem(event.data);
+            events.publish(Events.QUEUE_LOAD, {
+                items: [event.data]
+            });
+            return loading;
         });
     }
 
@@ -303,14 +624,10 @@ export default function JWMediaManager(receiverManager, container, events, analy
     function onSeek(event) {
         if (playerInstance &&
             event.data.mediaSessionId == mediaStatus.mediaSessionId) {
-            if (event.data.currentTime >= 0) {
-                playerInstance.once('seeked', () => {
-                    // Ensure that we broadcast a status update with the requestId
-                    // for the SEEK event, so that senders can properly corellate
-                    // requests and responses.
-                    broadcastStatus(event.data.requestId);
-                });
-                playerInstance.seek(event.data.currentTime);
+            if (event.data.currentTime !== undefined) {
+                // Acknowledge the SEEK request once the player has seeked.
+                pendingRequests.defer(event.senderId, event.data.requestId, Completion.SEEKED);
+                requestSeek(event.data.currentTime);
             }
             if (event.data.resumeState) {
                 playerInstance.play(event.data.resumeState == SeekResumeState.PLAYBACK_START);
@@ -337,8 +654,21 @@ export default function JWMediaManager(receiverManager, container, events, analy
     }
 
     function onGetStatus(event) {
-        // TODO: NO_METADATA and NO_QUEUE_ITEMS flags support.
-        sendStatus(event.senderId, event.data.requestId);
+        let customData = event.data.customData;
+        let options = event.data.options || 0;
+        let elements = [];
+
+        // Senders that are up to date only need the small fields.
+        let notModified = customData && customData.statusVersion === mediaStatusVersion;
+        if (!notModified) {
+            if (!(options & GetStatusOptions.NO_METADATA)) {
+                elements.push(MediaStatusFlags.META);
+            }
+            if (!(options & GetStatusOptions.NO_QUEUE_ITEMS)) {
+                elements.push(MediaStatusFlags.QUEUE);
+            }
+        }
+        sendRequestedStatus(event.senderId, event.data.requestId, elements, event.limited);
     }
 
     function onEditTracksInfo(event) {
@@ -365,7 +695,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
             let disableCaptions = true;
 
             activeTrackIds.forEach(trackId => {
-                let track = getTrackById(trackId);
+                let track = trackRegistry.getById(trackId);
                 if (track) {
                     if (track.type == TrackType.TEXT) {
                         let playerTracks = playerInstance.getCaptionsList();
@@ -373,6 +703,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
                             if (playerTrack.id == track.trackContentId) {
                                 disableCaptions = false;
                                 if (playerInstance.getCurrentCaptions() != index) {
+                                    pendingRequests.defer(event.senderId, event.data.requestId, Completion.TRACKS);
                                     playerInstance.setCurrentCaptions(index);
                                 }
                                 return true;
@@ -380,7 +711,10 @@ export default function JWMediaManager(receiverManager, container, events, analy
                         });
                     } else if (track.type == TrackType.AUDIO) {
                     // trackContentId for audio tracks match jwplayer.js's trackIndex.
-                        playerInstance.setCurrentAudioTrack(track.trackContentId);
+                        if (playerInstance.getCurrentAudioTrack() != track.trackContentId) {
+                            pendingRequests.defer(event.senderId, event.data.requestId, Completion.TRACKS);
+                            playerInstance.setCurrentAudioTrack(track.trackContentId);
+                        }
                     } else if (track.type == TrackType.VIDEO) {
                     // TODO
                     }
@@ -392,7 +726,8 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
             // Disable caption tracks if no active tracks
             // have been supplied.
-            if (disableCaptions) {
+            if (disableCaptions && playerInstance.getCurrentCaptions() != TRACK_DISABLED) {
+                pendingRequests.defer(event.senderId, event.data.requestId, Completion.TRACKS);
                 playerInstance.setCurrentCaptions(TRACK_DISABLED);
             }
         }
@@ -401,108 +736,87 @@ export default function JWMediaManager(receiverManager, container, events, analy
     }
 
     function onQueueLoad(event) {
-        if (isLoading) {
-            // Send load cancelled.
-            sendErrorLoadCancelled(event);
+        // The validator only knows the lower bound.
+        if (event.data.startIndex >= event.data.items.length) {
+            sendErrorInvalidRequest(event, ErrorReason.INVALID_PARAMS);
+            return;
         }
-        // Create a new MediaSession.
-        createMediaSession();
-
-        event.data.items.forEach((item, index) => {
-            item.itemId = ++index;
-        });
+        requestLoad(event, () => {
+            // Create a new MediaSession.
+            createMediaSession();
 
-        // Associate it with a queue.
-        mediaStatus.items = event.data.items;
-        mediaStatus.repeatMode = event.data.repeatMode;
+            // Associate it with a queue, this numbers the items.
+            queue = new MediaQueue(event.data.items);
+            mediaStatus.repeatMode = event.data.repeatMode;
 
-        let mediaItem = mediaStatus.items[event.data.startIndex];
+            // Load the first item.
+            let loading = loadItem(queue.get(event.data.startIndex || 0));
 
-        // Load the first item.
-        loadItem(mediaItem)
-            .then(() => {
-                isLoading = false;
-                sendStatus(event.senderId, event.data.requestId);
-            }, (error) => {
-                currentRequestId = event.data.requestId;
-                handleSetupError(error);
+            events.publish(Events.QUEUE_LOAD, {
+                items: event.data.items,
+                repeatMode: mediaStatus.repeatMode
             });
 
-        events.publish(Events.QUEUE_LOAD, {
-            items: mediaStatus.items,
-            repeatMode: mediaStatus.repeatMode
+            // Update receivers with the new queue.
+            setStatusFlag(MediaStatusFlags.QUEUE);
+            return loading;
         });
-
-        // Update receivers with the new queue.
-        // mediaStatusFlags.push(MediaStatusFlags.QUEUE);
     }
 
     function onQueueInsert(event) {
-        // Find the highest itemId in mediaStatus.items
-        let id = 1;
-        mediaStatus.items.forEach((item) => {
-            if (item.itemId >= id) {
-                id = item.itemId + 1;
-            }
-        });
-
-        // Start numbering from that id.
-        event.data.items.forEach((item) => {
-            item.itemId = id++;
-        });
-
-        // Check whether items should be added at the end of the queue.
-        if (!event.data.insertBefore) {
-            // Append the new items to the queue.
-            mediaStatus.items = mediaStatus.items.concat(event.data.items);
-        } else {
-            // Figure out where we need to insert something.
-            let insertBeforeIndex = findIndexOfItem(event.data.insertBefore);
-            // Insert the elements at the correct index using a nifty trick
-            // in order to prevent an extra array loop.
-            Array.prototype.splice.apply(mediaStatus.items, [insertBeforeIndex, 0].concat(event.data.items));
+        if (!queue) {
+            queue = new MediaQueue();
         }
 
+        // Number the items and insert them at the requested position.
+        let itemIds = queue.insert(event.data.items, event.data.insertBefore);
+        setStatusFlag(MediaStatusFlags.QUEUE);
+        broadcastQueueChange(event, QueueChangeType.INSERT, itemIds, event.data.insertBefore);
+
         // Check if we need to load a new item.
         let nextItem;
         if (event.data.currentItemIndex !== undefined) {
-            nextItem = mediaStatus.items[event.data.currentItemIndex];
-        } else if (event.data.currentItem && event.data.currentItem != mediaStatus.currentItem) {
-            nextItem = mediaStatus.items[findIndexOfItem(event.data.currentItem)];
+            nextItem = queue.get(event.data.currentItemIndex);
+        } else if (event.data.currentItemId && event.data.currentItemId != mediaStatus.currentItemId) {
+            nextItem = queue.getById(event.data.currentItemId);
         }
 
         if (nextItem) {
             // Yes, load a new item.
             nextItem.startTimeOverride = event.data.currentTime;
-            loadItem(nextItem).catch(handleSetupError);
+            loadRequestedItem(event, nextItem);
         } else {
             // Loading not needed.
             broadcastStatus();
         }
 
         events.publish(Events.QUEUE_UPDATE, {
-            items: mediaStatus.items
+            itemIds: itemIds
         });
     }
 
     function onQueueUpdate(event) {
+        if (!queue) {
+            sendErrorInvalidPlayerState(event);
+            return;
+        }
         if (event.data.currentItemId) {
-            let nextItem = mediaStatus.items[findIndexOfItem(event.data.currentItemId)];
+            let nextItem = queue.getById(event.data.currentItemId);
             nextItem.startTimeOverride = event.data.currentTime;
-            loadItem(nextItem).catch(handleSetupError);
+            loadRequestedItem(event, nextItem);
         } else if (event.data.jump) {
             let newIndex = getCurrentQueueIndex() + event.data.jump;
             // Check if newIndex needs to wrap around the queue boundaries.
-            if (newIndex >= mediaStatus.items.length) {
-                newIndex -= mediaStatus.items.length;
+            if (newIndex >= queue.length) {
+                newIndex -= queue.length;
             }
             if (newIndex < 0) {
-                newIndex += mediaStatus.items.length;
+                newIndex += queue.length;
             }
-            let nextItem = mediaStatus.items[getCurrentQueueIndex() + event.data.jump];
+            let nextItem = queue.get(newIndex);
             // Override the startTime, if necessary.
             nextItem.startTimeOverride = event.data.currentTime;
-            loadItem(nextItem).catch(handleSetupError);
+            loadRequestedItem(event, nextItem);
         }
         // Check whether repeatMode requires updating.
         if (event.data.repeatMode) {
@@ -511,23 +825,17 @@ export default function JWMediaManager(receiverManager, container, events, analy
     }
 
     function onQueueRemove(event) {
-        if (!event.data.itemIds || event.data.itemIds.length == 0) {
-            // err: invalid args
-            sendErrorInvalidRequest(event, ErrorReason.INVALID_COMMAND);
-            return;
-        }
-        if (mediaStatus.items.length == 0) {
+        if (!queue || queue.length == 0) {
             sendErrorInvalidPlayerState(event);
             return;
         }
-        event.data.itemIds.forEach((id) => {
-            let idx = findIndexOfItem(id);
-            mediaStatus.items.splice(idx, 1);
-        });
+        let removedItemIds = queue.remove(event.data.itemIds);
+        setStatusFlag(MediaStatusFlags.QUEUE);
+        broadcastQueueChange(event, QueueChangeType.REMOVE, removedItemIds);
         if (event.data.currentItemId && event.data.currentItemId != mediaStatus.currentItemId) {
-            let nextItem = mediaStatus.items[findIndexOfItem(event.data.currentItemId)];
+            let nextItem = queue.getById(event.data.currentItemId);
             nextItem.startTimeOverride = event.data.currentTime;
-            loadItem(nextItem).catch(handleSetupError);
+            loadRequestedItem(event, nextItem);
         } else if (getCurrentQueueIndex() === -1) {
                 // Current queue item has been removed to, stop playback.
             if (playerInstance) {
@@ -542,61 +850,97 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
     function onQueueReorder(event) {
         let itemIds = event.data.itemIds;
-        if (!itemIds) {
+        if (!queue) {
             sendErrorInvalidRequest(event, ErrorReason.INVALID_COMMAND);
             return;
         }
 
-        if (event.data.insertBefore) {
-            // Find the index of the queue item we want to insert before.
-            let insertBeforeIndex = findIndexOfItem(event.data.insertBefore);
-
-            if (!insertBeforeIndex) {
-                // err: could not find item to insert before.
-                sendErrorInvalidRequest(event, ErrorReason.INVALID_COMMAND);
-                return;
-            }
-
-            // insertBefore is specified, and we have found the item to insert before,
-            // re-order in the following fashion:
-            //
-            // If insertBefore is “A”
-            // Existing queue: “A”,”D”,”G”,”H”,”B”
-            // itemIds: “D”,”H”,”B”
-            // New Order: “D”,”H”,”B”,“A”,”G”,”E”
-            for (let i = insertBeforeIndex; itemIds.length > 0; i++) {
-                // Get the mediaItem to reorder from the queue.
-                let itemToMove = mediaStatus.items.splice(findIndexOfItem(itemIds.shift()), 1)[0]; // TODO: check for index not being out of bounds
-                // Insert the item at the new index.
-                mediaStatus.items.splice(i - 1, 0, itemToMove);
-            }
-        } else {
-            // insertBefore is not specificied, re-order in the following fashion:
-            // Existing queue: “A”,”D”,”G”,”H”,”B”,”E”
-            // itemIds: “D”,”H”,”B”
-            // New Order: “A”,”G”,”E”,“D”,”H”,”B”
-            while (itemIds.length) {
-                let itemToMove = mediaStatus.items.splice(findIndexOfItem(itemIds.shift()), 1)[0];
-                mediaStatus.items.push(itemToMove);
-            }
+        if (event.data.insertBefore && !queue.has(event.data.insertBefore)) {
+            // err: could not find item to insert before.
+            sendErrorInvalidRequest(event, ErrorReason.INVALID_COMMAND);
+            return;
         }
 
+        // If insertBefore is specified, re-order in the following fashion:
+        //
+        // If insertBefore is “A”
+        // Existing queue: “A”,”D”,”G”,”H”,”B”,”E”
+        // itemIds: “D”,”H”,”B”
+        // New Order: “D”,”H”,”B”,“A”,”G”,”E”
+        //
+        // If insertBefore is not specificied, re-order in the following fashion:
+        // Existing queue: “A”,”D”,”G”,”H”,”B”,”E”
+        // itemIds: “D”,”H”,”B”
+        // New Order: “A”,”G”,”E”,“D”,”H”,”B”
+        let movedItemIds = queue.reorder(itemIds, event.data.insertBefore);
+
         // Update the senders with the new queue.
+        setStatusFlag(MediaStatusFlags.QUEUE);
+        broadcastQueueChange(event, QueueChangeType.UPDATE, movedItemIds, event.data.insertBefore);
         broadcastStatus();
     }
 
+    function onQueueGetItemIds(event) {
+        sendMessage(event.senderId, {
+            type: MessageType.QUEUE_ITEM_IDS,
+            requestId: event.data.requestId || 0,
+            itemIds: queue ? queue.toArray().map(item => item.itemId) : []
+        });
+    }
+
+    function onQueueGetItems(event) {
+        let itemIds = event.data.itemIds;
+        if (!(itemIds instanceof Array) || itemIds.length > MAX_QUEUE_ITEMS_PER_REQUEST) {
+            sendErrorInvalidRequest(event, ErrorReason.INVALID_PARAMS);
+            return;
+        }
+        let items = [];
+        itemIds.forEach(itemId => {
+            let item = queue ? queue.getById(itemId) : undefined;
+            if (item) {
+                items.push(item);
+            }
+        });
+        sendMessage(event.senderId, {
+            type: MessageType.QUEUE_ITEMS,
+            requestId: event.data.requestId || 0,
+            items: items
+        });
+    }
+
+    function onQueueGetItemRange(event) {
+        let index = queue ? queue.indexOf(event.data.itemId) : -1;
+        if (index == -1) {
+            sendErrorInvalidRequest(event, ErrorReason.INVALID_PARAMS);
+            return;
+        }
+        // Collect the ids of the window around the item.
+        let first = Math.max(0, index - (event.data.prevCount || 0));
+        let last = Math.min(queue.length - 1, index + (event.data.nextCount || 0));
+        let itemIds = [];
+        for (let i = first; i <= last; i++) {
+            itemIds.push(queue.get(i).itemId);
+        }
+        sendMessage(event.senderId, {
+            type: MessageType.QUEUE_ITEM_IDS,
+            requestId: event.data.requestId || 0,
+            itemIds: itemIds
+        });
+    }
+
     function onPreload(event) {
-        // Not supported currently.
-        // We might be able to support this by
-        // creating multiple player instances.
-        sendError(MessageType.INVALID_REQUEST,
-            ErrorReason.INVALID_COMMAND, event);
+        let item = queue ? queue.getById(event.data.itemId) : undefined;
+        if (!item) {
+            sendErrorInvalidRequest(event, ErrorReason.INVALID_PARAMS);
+            return;
+        }
+        preloadItem(item);
+        broadcastStatus();
     }
 
     function onCancelPreload(event) {
-        // Not supported currently.
-        sendError(MessageType.INVALID_REQUEST,
-            ErrorReason.INVALID_COMMAND, event);
+        cancelPreload();
+        broadcastStatus();
     }
 
     /*
@@ -615,14 +959,28 @@ export default function JWMediaManager(receiverManager, container, events, analy
     /**
      * Handler for JW Player setupErrors.
      * @param  {Object} setupError The setupError to handle.
+     * @param  {Array<{senderId: string, requestId: number}>} requests The requests that failed.
      */
-    function handleSetupError(setupError) {
+    function handleSetupError(setupError, requests) {
+        if (setupError && setupError.cancelled) {
+            // A superseded load, not an error.
+            return;
+        }
         console.error('Failed to initialize player: %O', setupError);
-        broadcastMessage({
-            type: MessageType.LOAD_FAILED,
-            requestId: currentRequestId ? currentRequestId : 0
+        (requests && requests.length ? requests : [{ requestId: 0 }]).forEach(request => {
+            let message = JSON.stringify({
+                type: MessageType.LOAD_FAILED,
+                requestId: request.requestId ? request.requestId : 0
+            });
+            if (request.senderId) {
+                // requestIds are only unique per sender, the others learn
+                // about the error from the status broadcast.
+                requestCache.setReply(request.senderId, request.requestId, message);
+                sendMessage(request.senderId, message);
+            } else {
+                broadcastMessage(message);
+            }
         });
-        currentRequestId = 0;
         mediaStatus.playerState = PlayerState.IDLE;
         mediaStatus.idleReason = IdleReason.ERROR;
         broadcastStatus();
@@ -634,7 +992,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
     function handleMediaError(error) {
         let nextItem = getNextItemInQueue();
         let willAdvance = nextItem || mediaStatus.repeatMode == RepeatMode.REPEAT_ALL_AND_SHUFFLE
-            && mediaStatus.items && mediaStatus.items.length > 2;
+            && queue && queue.length > 2;
 
         events.publish(Events.MEDIA_ERROR, {
             error: error,
@@ -657,10 +1015,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
      */
     function handleTime(event) {
         // Update the UI
-        events.publish(Events.MEDIA_TIME, {
-            currentTime: event.position,
-            duration: event.duration
-        });
+        timePipeline.update(event.position, event.duration);
         if (mediaStatus) {
             mediaStatus.currentTime = event.position;
 
@@ -670,27 +1025,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
                 // update for a playing event, if this is
                 // the first time we figure out a duration.
                 broadcastStatusUpdate = true;
-                let media = mediaStatus.media;
-                media.duration = event.duration;
-
-                // Update mediaStatus.breaks with breaks that require
-                // the duration to be known (e.g. postrolls & ads with a percentual offset).
-                if (media.customData && media.customData.advertising
-                    && media.customData.advertising.schedule) {
-                    let adBreaks = mediaStatus.media.breaks || [];
-                    let adSchedule = media.customData.advertising.schedule;
-                    Object.keys(adSchedule).forEach(breakId => {
-                        let adBreak = adSchedule[breakId];
-                        if (adBreak.offset.indexOf('%') !== -1
-                        && adBreak.offset !== 'post') {
-                            return;
-                        }
-                        let adPosition = adBreak.offset === 'post' ?
-                        media.duration : offsetTime(adBreak.offset, media.duration);
-                        adBreaks.push(new AdBreakInfo(breakId, adPosition));
-                    });
-                    mediaStatus.media.breaks = adBreaks;
-                }
+                updateDuration(event.duration);
             }
             // TODO: live stream support - chromecast does not
             // expect jwplayer's definition of position for the
@@ -698,80 +1033,158 @@ export default function JWMediaManager(receiverManager, container, events, analy
             if (broadcastStatusUpdate) {
                 broadcastStatus();
             }
+
+            maybePreloadNextItem(event.position, event.duration);
+
+            if (awaitingPlayback && !seekInFlight) {
+                // Playback resumed after a burst of seeks.
+                awaitingPlayback = false;
+                seekStats.lastLatency = Date.now() - scrubStartTime;
+                seekStats.totalLatency += seekStats.lastLatency;
+                scrubStartTime = 0;
+            }
         }
     }
 
     /**
-     * Handler for JW Player on('captionList') events.
+     * Seeks to the given time, or queues the seek if the player is seeking
+     * already. Only the latest queued target is applied, so that scrubbing
+     * doesn't make the player seek to every position in between.
+     * @param {number} time The time to seek to, in seconds.
      */
-    function handleCaptions(captionListEvent) {
-        let tracksChanged = false;
-        mediaStatus.media.tracks = mediaStatus.media.tracks || [];
+    function requestSeek(time) {
+        seekStats.requests++;
+        if (seekInFlight) {
+            queuedSeekTime = time;
+            return;
+        }
+        if (!scrubStartTime) {
+            scrubStartTime = Date.now();
+        }
+        applySeek(time);
+    }
 
-        // Update mediaStatus.media.tracks/activeTrackIds and send status if applicable.
-        captionListEvent.tracks.forEach((captionTrack, trackIndex) => {
-            if (trackIndex == 0) {
-            // trackIndex 0 is always off.
-                return;
+    function applySeek(time) {
+        seekInFlight = true;
+        seekStats.applied++;
+        window.clearTimeout(seekTimeoutId);
+        seekTimeoutId = window.setTimeout(handleSeeked, SEEK_TIMEOUT);
+        playerInstance.seek(time);
+    }
+
+    /**
+     * Handler for the JW Player on('seeked') event.
+     * Applies the queued seek, if any, or acknowledges all SEEK requests
+     * of the burst with a single status update.
+     */
+    function handleSeeked() {
+        window.clearTimeout(seekTimeoutId);
+        if (queuedSeekTime >= 0) {
+            let time = queuedSeekTime;
+            queuedSeekTime = -1;
+            applySeek(time);
+            return;
+        }
+        if (seekInFlight) {
+            seekInFlight = false;
+            seekStats.scrubs++;
+            // Paused players don't resume, there is no latency to measure.
+            awaitingPlayback = mediaStatus.playerState != PlayerState.PAUSED;
+            if (!awaitingPlayback) {
+                scrubStartTime = 0;
             }
+        }
+        completeRequests(Completion.SEEKED, true);
+    }
 
-            let newTrack = mediaStatus.media.tracks.length == 0
-            || !mediaStatus.media.tracks.some(track => track.type == TrackType.TEXT
-            && track.trackContentId == captionTrack.id);
+    /**
+     * Forgets about seeks in progress, e.g. when a new item is loaded.
+     */
+    function resetSeek() {
+        window.clearTimeout(seekTimeoutId);
+        seekInFlight = false;
+        queuedSeekTime = -1;
+        awaitingPlayback = false;
+        scrubStartTime = 0;
+        completeRequests(Completion.SEEKED, true);
+    }
 
-            if (newTrack) {
-            // Build a new cast.receiver.media.Track object, add it to mediaStatus.media.tracks.
-                mediaStatus.media.tracks.push({
+    /**
+     * Handler for JW Player on('captionsList') events.
+     */
+    function handleCaptions(captionListEvent) {
+        let tracksChanged = false;
+        captionListEvent.tracks.forEach((captionTrack, trackIndex) => {
+            // trackIndex 0 is always off.
+            if (trackIndex > 0) {
+                tracksChanged = trackRegistry.add({
                     name: captionTrack.label,
                     trackContentId: captionTrack.id,
-                    trackId: generateTrackId(),
                     type: TrackType.TEXT,
                     subtype: TextTrackType.CAPTIONS // TODO: distinguish between CC and SUBTITLES
-                });
-                tracksChanged = true;
+                }) || tracksChanged;
             }
         });
-
-        if (captionListEvent.track == 0 && !tracksChanged) {
-            // If the caption track is disabled, make sure
-            // that we update the array of activeTrackIds.
-            tracksChanged = updateActiveTracks();
+        if (tracksChanged) {
+            setStatusFlag(MediaStatusFlags.META);
         }
 
-        if (tracksChanged) {
+        if (updateActiveCaptions(captionListEvent) || tracksChanged) {
             broadcastStatus();
         }
     }
 
     /**
-     * Handler for JW Player on('audioTrack') events.
+     * Handler for JW Player on('audioTracks') events.
      */
     function handleAudioTracks(event) {
         let tracksChanged = false;
-        mediaStatus.media.tracks = mediaStatus.media.tracks || [];
-
         event.tracks.forEach((audioTrack, index) => {
-            let newTrack = mediaStatus.media.tracks.length == 0
-                || !mediaStatus.media.tracks.some(track => track.type == TrackType.AUDIO
-                && track.trackContentId == index);
-
-            if (newTrack) {
-                mediaStatus.media.tracks.push({
-                    name: audioTrack.name,
-                    trackContentId: index,
-                    type: TrackType.AUDIO,
-                    trackId: generateTrackId()
-                });
-                tracksChanged = true;
-            }
+            // trackContentId for audio tracks match jwplayer.js's trackIndex.
+            tracksChanged = trackRegistry.add({
+                name: audioTrack.name,
+                trackContentId: index,
+                type: TrackType.AUDIO
+            }) || tracksChanged;
         });
-
         if (tracksChanged) {
-            updateActiveTracks();
+            setStatusFlag(MediaStatusFlags.META);
+        }
+
+        if (updateActiveAudioTrack(event) || tracksChanged) {
             broadcastStatus();
         }
     }
 
+    /**
+     * Updates the active text track from a captionsList or captionsChanged event.
+     *
+     * @return {boolean} Whether the active tracks have changed.
+     */
+    function updateActiveCaptions(event) {
+        // Track 0 disables captions.
+        let captionTrack = event.track > 0 ? event.tracks[event.track] : null;
+        return updateActiveTrack(TrackType.TEXT, captionTrack ? captionTrack.id : null);
+    }
+
+    /**
+     * Updates the active audio track from an audioTracks or audioTrackChanged event.
+     *
+     * @return {boolean} Whether the active tracks have changed.
+     */
+    function updateActiveAudioTrack(event) {
+        // -1 = no alternative tracks
+        return updateActiveTrack(TrackType.AUDIO, event.currentTrack >= 0 ? event.currentTrack : null);
+    }
+
+    function updateActiveTrack(type, trackContentId) {
+        if (!trackRegistry.setActive(type, trackContentId)) {
+            return false;
+        }
+        mediaStatus.activeTrackIds = trackRegistry.activeTrackIds;
+        return true;
+    }
+
     /**
      * Handler for the JW Player on('adImpression') events.
      * Used for IMA only.
@@ -784,7 +1197,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
         // Since IMA does not expose the on('adMeta') event,
         // we'll build an adMeta object and then trigger the adMeta handler.
-        let adMeta = new AdMeta();
+        let adMeta = new ads.AdMeta();
 
         // Copy the keys that are in both adMeta and event
         // to adMeta.
@@ -813,7 +1226,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
         let adSelectionSettings = new google.ima.CompanionAdSelectionSettings();
         adSelectionSettings.sizeCriteria = google.ima.CompanionAdSelectionSettings.SizeCriteria.IGNORE;
-        adMeta.companions = AdCompanion.convertImaCompanions(ad.getCompanionAds(300, 250, adSelectionSettings));
+        adMeta.companions = ads.AdCompanion.convertImaCompanions(ad.getCompanionAds(300, 250, adSelectionSettings));
 
         // Forward the meta object to the adMeta handler.
         handleAdMeta(adMeta);
@@ -836,73 +1249,26 @@ export default function JWMediaManager(receiverManager, container, events, analy
             adPodStartTime = Date.now();
         }
 
-        // Populate mediaStatus.media.breaks and mediaStatus.media.breakClips.
+        // Populate mediaStatus.media.breakClips.
         let adSchedule = playerInstance.getPlaylist()[playerInstance.getPlaylistIndex()].adschedule;
-        if (adSchedule) {
-            let breaks = mediaStatus.media.breaks;
-            if (!breaks) {
-                // We are dealing with a preroll, the duration of the media is unknown
-                // and because of that the breaks have not yet been initialized.
-                // We initialize an array of breaks, but we do not add the breaks
-                // that require the duration to be known.
-                breaks = [];
-                let schedule = mediaStatus.media.customData.advertising.schedule;
-                Object.keys(schedule).forEach(breakId => {
-                    let adBreak = schedule[breakId];
-                    if (adBreak.offset.indexOf('%') != -1
-                    || adBreak.offset === 'post') {
-                        return;
-                    }
+        if (adSchedule && adTimeline) {
+            // The tags in the player's schedule are the ones that adMeta reports.
+            adTimeline.indexTags(adSchedule);
+            let currentBreakId = adTimeline.getBreakIdByTag(event.tag);
 
-                    let breakPosition;
-                    if (adBreak.offset == 'pre') {
-                        breakPosition = 0;
-                    } else {
-                        breakPosition = adBreak.offset.indexOf(':') != -1 ?
-                        jwplayer.utils.seconds(adBreak.offset) : Number.parseFloat(adBreak.offset);
-                    }
-                    breaks.push(new AdBreakInfo(breakId, breakPosition));
-                    mediaStatus.media.breaks = breaks;
-                });
-            }
-
-            let breakClips = mediaStatus.media.breakClips || [];
-
-            // First find the "id" of the current ad break.
-            let currentBreakId = null;
-            Object.keys(adSchedule).some(breakId => {
-                if (adSchedule[breakId].tag == event.tag) {
-                    currentBreakId = breakId;
-                    return true;
-                }
-            });
-
-            // Next find the break by "id" in the current "breaks" array.
-            let currentBreak = null;
-            breaks.some((adBreak) => {
-                if (adBreak.id == currentBreakId) {
-                    currentBreak = adBreak;
-                    return true;
-                }
-            });
-
-            // Okay, now we should have all the ingredients to build
-            // an adBreakClipInfo which we can associate to a "break".
-            let adBreakClipInfo = new AdBreakClipInfo(event.id);
-            adBreakClipInfo.clickThroughUrl = event.clickthrough;
-            adBreakClipInfo.title = event.title;
-            adBreakClipInfo.mimeType = event.creativetype;
+            // Okay, now we should have all the ingredients to build
+            // an adBreakClipInfo which we can associate to a "break".
+            let adBreakClipInfo = new ads.AdBreakClipInfo(event.id);
+            adBreakClipInfo.clickThroughUrl = event.clickthrough;
+            adBreakClipInfo.title = event.title;
+            adBreakClipInfo.mimeType = event.creativetype;
 
             // Update the media status.
-            breakClips.push(adBreakClipInfo);
-            mediaStatus.media.breakClips = breakClips;
-
-            let breakClipIds = currentBreak.breakClipIds || [];
-            breakClipIds.push(adBreakClipInfo.id);
-            currentBreak.breakClipIds = breakClipIds;
+            adTimeline.addClip(adBreakClipInfo, currentBreakId);
+            updateAdBreakInfo();
 
             // Now update the breakStatus
-            let adBreakStatus = new AdBreakStatus(0.0, 0.0);
+            let adBreakStatus = new ads.AdBreakStatus(0.0, 0.0);
             adBreakStatus.breakId = currentBreakId;
             adBreakStatus.breakClipId = adBreakClipInfo.id;
             adBreakStatus.whenSkippable = event.skipoffset ? event.skipoffset : -1;
@@ -917,20 +1283,17 @@ export default function JWMediaManager(receiverManager, container, events, analy
      */
     function handleAdTime(event) {
         events.publish(Events.AD_TIME, event);
-        if (mediaStatus.breakStatus) {
+        if (mediaStatus.breakStatus && adTimeline) {
             let adBreakStatus = mediaStatus.breakStatus;
             adBreakStatus.currentBreakClipTime = event.position;
             adBreakStatus.currentBreakTime = (Date.now() - adPodStartTime) / 1000;
 
             // Update the ad duration.
-            // TODO: prevent look-up of the adBreak in mediaStatus.media.breaks for
-            // every time update?
-            mediaStatus.media.breakClips.some(breakClip => {
-                if (breakClip.id === adBreakStatus.breakClipId) {
-                    breakClip.duration = event.duration;
-                    return true;
-                }
-            });
+            let breakClip = adTimeline.getClip(adBreakStatus.breakClipId);
+            if (breakClip && breakClip.duration != event.duration) {
+                breakClip.duration = event.duration;
+                setStatusFlag(MediaStatusFlags.META);
+            }
             // TODO: update duration of the current ad break?
         }
     }
@@ -944,13 +1307,11 @@ export default function JWMediaManager(receiverManager, container, events, analy
         delete customData.adMeta;
 
         // Update the isWatched property if necessary.
-        mediaStatus.media.breaks.some(adBreak => {
-            if (adBreak.breakClipIds
-        && adBreak.breakClipIds.indexOf(event.id) != -1) {
-                adBreak.isWatched = true;
-                return true;
-            }
-        });
+        let adBreak = adTimeline && adTimeline.getBreakOfClip(event.id);
+        if (adBreak && !adBreak.isWatched) {
+            adBreak.isWatched = true;
+            setStatusFlag(MediaStatusFlags.META);
+        }
 
         delete mediaStatus.breakStatus;
         broadcastStatus();
@@ -960,69 +1321,218 @@ export default function JWMediaManager(receiverManager, container, events, analy
      * Utility functions.
      */
 
+    /**
+     * Handles a LOAD or QUEUE_LOAD request.
+     *
+     * A request that arrives while another one is loading cancels that load,
+     * and waits for LOAD_COALESCE_WINDOW before it starts. Requests that
+     * arrive in the meantime replace it, so only the last request of a burst
+     * sets up the player. Every superseded request gets a LOAD_CANCELLED.
+     *
+     * @param {Object} event The request.
+     * @param {function(): Promise} load Starts the load.
+     */
+    function requestLoad(event, load) {
+        if (deferredLoad) {
+            // Superseded before it started.
+            window.clearTimeout(deferredLoad.timeoutId);
+            sendErrorLoadCancelled(deferredLoad.event);
+            deferredLoad = null;
+        }
+        if (!isLoading) {
+            startLoad(event, load);
+            return;
+        }
+
+        // Keep isLoading set while we wait, the cancelled load
+        // sends its LOAD_CANCELLED when its promise rejects.
+        loadingEvent = null;
+        cancelLoad();
+        deferredLoad = {
+            event: event,
+            timeoutId: window.setTimeout(() => {
+                deferredLoad = null;
+                startLoad(event, load);
+            }, LOAD_COALESCE_WINDOW)
+        };
+    }
+
+    function startLoad(event, load) {
+        isLoading = true;
+        loadingEvent = event;
+        load().then(() => {
+            finishLoad(event);
+            sendStatus(event.senderId, event.data.requestId, ALL_STATUS_ELEMENTS);
+            // Status updates are held back while loading, the other senders
+            // learn about the new media session from this broadcast.
+            ALL_STATUS_ELEMENTS.forEach(flag => {
+                if (mediaStatusFlags.indexOf(flag) < 0) {
+                    mediaStatusFlags.push(flag);
+                }
+            });
+            broadcastStatus();
+        }, (error) => {
+            finishLoad(event);
+            if (error && error.cancelled) {
+                sendErrorLoadCancelled(event);
+            } else {
+                handleSetupError(error, [{
+                    senderId: event.senderId,
+                    requestId: event.data.requestId
+                }]);
+            }
+        });
+    }
+
+    function finishLoad(event) {
+        // Loads that have been superseded by another request leave
+        // isLoading alone.
+        if (loadingEvent === event) {
+            loadingEvent = null;
+            isLoading = false;
+        }
+    }
+
+    /**
+     * Cancels the loadItem() call in progress, and stops the player from
+     * loading its media.
+     */
+    function cancelLoad() {
+        if (currentLoad) {
+            currentLoad.cancel();
+            removeStateListeners();
+            if (playerInstance) {
+                playerInstance.stop();
+            }
+        }
+    }
+
+    /**
+     * Loads an item on behalf of a request, which is acknowledged once
+     * the item has been loaded.
+     * @param {Object} event The request.
+     * @param {MediaQueueItem} item The item to load.
+     */
+    function loadRequestedItem(event, item) {
+        pendingRequests.defer(event.senderId, event.data.requestId, Completion.LOADED);
+        loadItem(item).then(() => {
+            completeRequests(Completion.LOADED);
+        }, error => {
+            if (!error.cancelled) {
+                handleSetupError(error, pendingRequests.take(Completion.LOADED));
+            }
+        });
+    }
+
     /**
      * Loads an item on JW Player.
+     *
+     * Loading another item cancels the load, its promise is then rejected
+     * with an error that has the cancelled property set.
      * @param {MediaInfo} the item to load, this can be a MediaQueue item, or a media item.
      */
     function loadItem(item) {
+        let media = item.media ? item.media : item;
+        if (!ads && media.customData && media.customData.advertising) {
+            return loadAdsChunk(item);
+        }
         return new Promise((resolve, reject) => {
+            let load = {
+                cancel: () => reject(createSupersededError())
+            };
+            if (currentLoad) {
+                currentLoad.cancel();
+            }
+            currentLoad = load;
+            // Settling the promise ends the load.
+            resolve = settleLoad(load, resolve);
+            reject = settleLoad(load, reject);
+
             // Broadcast a MEDIA_LOAD event.
+            timePipeline.reset();
             events.publish(Events.MEDIA_LOAD, {
                 item: item
             });
 
-            if (!playerInstance) {
-                playerInstance = jwplayer(container);
-            }
-
-            let media = item.media ? item.media : item;
-            let playlist = mediaToPlaylist(media);
-            let playerConfig = {
-                primary: 'html5',
-                width: '100%',
-                height: '100%',
-                playlist: playlist,
-                hlshtml: true,
-                autostart: item.autoplay ? item.autoplay : true,
-                controls: false,
-                analytics: analyticsConfig,
-            };
+            let loadStartTime = Date.now();
+            let autoplay = item.autoplay || item.autoplay === undefined;
+            let playerConfig = getPlayerConfig(item, media);
+            let configKey = getPlayerConfigKey(playerConfig);
 
-            let customMediaData = media.customData || {};
+            let startTime = 0;
+            if ((item.startTimeOverride || item.startTime) && item.streamType != 'LIVE') {
+                // TODO: Check for live.
+                startTime = item.startTimeOverride ? item.startTimeOverride : item.startTime;
 
-            if (customMediaData.advertising && customMediaData.advertising.client) {
-                playerConfig.advertising = {
-                    client: customMediaData.advertising.client
-                };
-            }
-            if (customMediaData.drm) {
-                playerConfig.drm = customMediaData.drm;
+                // The startTime can only be overridden once.
+                delete item.startTimeOverride;
             }
+            mediaStatus.currentTime = startTime;
 
-            // TODO: set textTrackStyle.
-            // if (playerInstance.getConfig()) {
-            //   playerInstance.stop();
-            // }
-            playerInstance.setup(playerConfig);
+            // Remove the listeners of the previous item.
+            removeStateListeners();
+            resetSeek();
+
+            let loadPath;
+            if (standby && standby.item === item) {
+                // The item has been set up on the standby player already.
+                loadPath = 'preload';
+                swapStandbyPlayer();
+                if (startTime) {
+                    playerInstance.seek(startTime);
+                }
+                if (autoplay) {
+                    playerInstance.play(true);
+                }
+            } else if (playerInstance && configKey === playerConfigKey) {
+                // The player has been set up with a compatible config,
+                // only the playlist needs to change.
+                loadPath = 'load';
+                if (startTime) {
+                    playerConfig.playlist[0].starttime = startTime;
+                }
+                playerInstance.load(playerConfig.playlist);
+                if (autoplay) {
+                    playerInstance.play(true);
+                }
+            } else {
+                loadPath = 'setup';
+                if (!playerInstance) {
+                    playerInstance = jwplayer(container);
+                }
 
-            mediaStatus.currentTime = 0;
-            if ((item.startTimeOverride || item.startTime) && item.streamType != 'LIVE') {
-                // TODO: Check for live.
-                let startTime = item.startTimeOverride ? item.startTimeOverride : item.startTime;
+                // TODO: set textTrackStyle.
+                // if (playerInstance.getConfig()) {
+                //   playerInstance.stop();
+                // }
+                playerInstance.setup(playerConfig);
+                playerConfigKey = configKey;
+            }
 
-                mediaStatus.currentTime = startTime;
-                playerInstance.once('ready', function() {
+            playerListeners = new ListenerRegistry(playerInstance);
+            if (loadPath == 'setup' && startTime) {
+                playerListeners.once('ready', function() {
                     playerInstance.seek(startTime);
                 });
-
-                // The startTime can only be overridden once.
-                delete item.startTimeOverride;
             }
 
-            mediaStatus.playerState = (item.autoplay || item.autoplay === undefined)
-            ? PlayerState.BUFFERING : PlayerState.PAUSED;
+            // Measure the time it takes to get to the first frame.
+            playerListeners.once('firstFrame', () => {
+                let stats = loadStats[loadPath] || {
+                    count: 0,
+                    totalTime: 0,
+                    lastTime: 0
+                };
+                stats.count++;
+                stats.lastTime = Date.now() - loadStartTime;
+                stats.totalTime += stats.lastTime;
+                loadStats[loadPath] = stats;
+            });
+
+            mediaStatus.playerState = autoplay ? PlayerState.BUFFERING : PlayerState.PAUSED;
             mediaStatus.media = media;
-            mediaStatus.activeTrackIds = [];
+            trackRegistry = new TrackRegistry(media);
+            mediaStatus.activeTrackIds = trackRegistry.activeTrackIds;
             // TODO:
             // Chrome senders might have issues if they receive a status
             // update with a media.duration of 0 when the player state is set to
@@ -1031,7 +1541,7 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
             // Ensure new media metadata gets pushed to
             // the senders.
-            // mediaStatusFlags.push(MediaStatusFlags.META);
+            setStatusFlag(MediaStatusFlags.META);
 
             // Update the currentItemId.
             if (item.itemId) {
@@ -1042,72 +1552,264 @@ export default function JWMediaManager(receiverManager, container, events, analy
 
             registerPlayerStateListeners();
 
-            playerInstance.once('setupError', reject);
-            playerInstance.once('error', reject);
-            if (mediaStatus.media.duration) {
-                // Update ad break info before resolving.
-                initAdBreakInfo(media);
+            if (loadPath == 'preload') {
+                // The standby player announced its tracks before we listened to it.
+                handleCaptions({
+                    tracks: playerInstance.getCaptionsList(),
+                    track: playerInstance.getCurrentCaptions()
+                });
+                handleAudioTracks({
+                    tracks: playerInstance.getAudioTracks() || [],
+                    currentTrack: playerInstance.getCurrentAudioTrack()
+                });
             }
 
-            let hasPreRoll = mediaStatus.media.breaks
-            && mediaStatus.media.breaks.some(adBreak => {
-                return adBreak.position === 0;
+            playerListeners.once('setupError', error => {
+                // Make sure the next item does a full setup.
+                playerConfigKey = null;
+                reject(error);
             });
+            playerListeners.once('error', reject);
+
+            // Update ad break info before resolving.
+            initAdTimeline(media);
+
+            // The standby player may have fired 'meta' before our listeners
+            // were added, and fires no 'time' events while it is paused.
+            let preloadedDuration = loadPath == 'preload' ? playerInstance.getDuration() : 0;
 
-            if (hasPreRoll && !mediaStatus.media.duration) {
+            if (adTimeline && adTimeline.hasPreRoll && !mediaStatus.media.duration) {
                 // It is impossible to determine the duration
                 // before playback.
                 resolve();
+            } else if (preloadedDuration > 0) {
+                updateDuration(preloadedDuration);
+                resolve();
             } else {
                 // Listen for the 'meta' event in order the duration
                 // before playback begins.
                 const onDuration = event => {
                     console.log('onDuration');
                     if (event.duration >= 0) {
-                        playerInstance.off('meta time', onDuration);
-                        mediaStatus.media.duration = event.duration;
+                        playerListeners.off('meta time', onDuration);
+                        updateDuration(event.duration);
                         resolve();
                     }
                 };
-                playerInstance.on('meta time', onDuration);
+                playerListeners.on('meta time', onDuration);
             }
         });
     }
 
+    /**
+     * Loads the ads chunk, and then the item. Until the chunk has been loaded
+     * the load can be cancelled like any other load.
+     */
+    function loadAdsChunk(item) {
+        return new Promise((resolve, reject) => {
+            let load = {
+                cancel: () => reject(createSupersededError())
+            };
+            if (currentLoad) {
+                currentLoad.cancel();
+            }
+            currentLoad = load;
+            ChunkLoader.load('ads').then((chunk) => {
+                ads = chunk;
+                if (currentLoad === load) {
+                    currentLoad = null;
+                    loadItem(item).then(resolve, reject);
+                }
+            }, settleLoad(load, reject));
+        });
+    }
+
+    function createSupersededError() {
+        let error = new Error('The load has been superseded.');
+        error.cancelled = true;
+        return error;
+    }
+
+    /**
+     * Wraps a resolve or reject callback of a load, so that it clears
+     * currentLoad when the load is still current.
+     */
+    function settleLoad(load, callback) {
+        return value => {
+            if (currentLoad === load) {
+                currentLoad = null;
+            }
+            callback(value);
+        };
+    }
+
+    /**
+     * Builds the JW Player config for an item.
+     * @param {MediaQueueItem} item The item to build a config for.
+     * @param {MediaInformation} media The media of the item.
+     * @param {boolean} preload Whether the config is used for preloading.
+     */
+    function getPlayerConfig(item, media, preload) {
+        let playerConfig = {
+            primary: 'html5',
+            width: '100%',
+            height: '100%',
+            playlist: mediaToPlaylist(media),
+            hlshtml: true,
+            autostart: preload ? false : (item.autoplay ? item.autoplay : true),
+            controls: false,
+            analytics: analyticsConfig,
+        };
+        if (preload) {
+            playerConfig.preload = 'auto';
+            playerConfig.mute = true;
+        }
+
+        let customMediaData = media.customData || {};
+
+        if (customMediaData.advertising && customMediaData.advertising.client) {
+            playerConfig.advertising = {
+                client: customMediaData.advertising.client
+            };
+        }
+        if (customMediaData.drm) {
+            playerConfig.drm = customMediaData.drm;
+        }
+        return playerConfig;
+    }
+
+    /**
+     * Returns a key for the parts of a player config that require a setup
+     * when they change, as opposed to the playlist.
+     * @param {Object} playerConfig The config, see getPlayerConfig().
+     */
+    function getPlayerConfigKey(playerConfig) {
+        return JSON.stringify({
+            advertising: playerConfig.advertising,
+            drm: playerConfig.drm,
+            analytics: playerConfig.analytics
+        });
+    }
+
+    /**
+     * Sets up an item on the hidden standby player, so that it can start
+     * playback without a full setup once it gets loaded.
+     * @param {MediaQueueItem} item The queue item to preload.
+     */
+    function preloadItem(item) {
+        if (standby && standby.item === item) {
+            // Preloading already.
+            return;
+        }
+        if (!standby) {
+            let element = document.createElement('div');
+            element.id = STANDBY_PLAYER_ELEMENT_ID;
+            // Elements stack in DOM order, keep both players below the
+            // overlay, which follows the active player.
+            let active = playerInstance ? playerInstance.getContainer() : container;
+            playerParent.insertBefore(element, active.nextSibling);
+            standby = {
+                player: jwplayer(element),
+                item: null
+            };
+        }
+        let media = item.media ? item.media : item;
+        let playerConfig = getPlayerConfig(item, media, true);
+        standby.item = item;
+        standby.configKey = getPlayerConfigKey(playerConfig);
+        standby.player.setup(playerConfig);
+    }
+
+    /**
+     * Stops preloading, the standby player is kept around for later use.
+     */
+    function cancelPreload() {
+        if (standby && standby.item) {
+            standby.player.stop();
+            standby.item = null;
+        }
+    }
+
+    /**
+     * Preloads the next item in the queue when the current item is
+     * about to end.
+     */
+    function maybePreloadNextItem(position, duration) {
+        if (!duration || duration <= 0 || !queue) {
+            return;
+        }
+        let nextItem = getNextItemInQueue();
+        if (!nextItem || nextItem.itemId === mediaStatus.currentItemId
+            || (standby && standby.item === nextItem)) {
+            return;
+        }
+        let preloadTime = typeof (nextItem.preloadTime) === 'number'
+            ? nextItem.preloadTime : DEFAULT_PRELOAD_TIME;
+        if (duration - position <= preloadTime) {
+            preloadItem(nextItem);
+        }
+    }
+
+    /**
+     * Makes the standby player the active player, the previously active
+     * player becomes the standby player.
+     */
+    function swapStandbyPlayer() {
+        let previousPlayer = playerInstance;
+        let player = standby.player;
+
+        if (previousPlayer) {
+            removeStateListeners();
+            previousPlayer.stop();
+            previousPlayer.getContainer().id = STANDBY_PLAYER_ELEMENT_ID;
+        }
+        player.getContainer().id = PLAYER_ELEMENT_ID;
+        player.setMute(false);
+
+        let previousConfigKey = playerConfigKey;
+        playerInstance = player;
+        playerConfigKey = standby.configKey;
+        standby = previousPlayer ? {
+            player: previousPlayer,
+            item: null,
+            configKey: previousConfigKey
+        } : null;
+    }
+
     function loadNextMediaItem() {
         let index;
-        let n;
-        let temp;
-        let i;
 
         if (mediaStatus) {
             switch (mediaStatus.repeatMode) {
                 case RepeatMode.REPEAT_OFF:
                     // Remove the current item from mediaSession/queue.
                     // Load next item on player and play.
-                    if (mediaStatus.items) {
+                    if (queue) {
                         // Pop the current item of the queue.
-                        mediaStatus.items.shift();
+                        let finishedItem = queue.shift();
+                        if (finishedItem) {
+                            broadcastQueueChange({}, QueueChangeType.REMOVE, [finishedItem.itemId]);
+                        }
                         // If there is a next item in the queue, play it.
-                        if (mediaStatus.items.length != 0) {
-                            loadItem(mediaStatus.items[0]).catch(handleSetupError);
+                        if (queue.length != 0) {
+                            loadItem(queue.get(0)).catch(handleSetupError);
                         } else {
                             mediaStatus.idleReason = IdleReason.FINISHED;
                         }
                         // Make sure to push the updated queue to connected
                         // senders.
-                        // mediaStatusFlags.push(MediaStatusFlags.QUEUE);
+                        setStatusFlag(MediaStatusFlags.QUEUE);
                     }
                     break;
                 case RepeatMode.REPEAT_ALL:
                     index = getCurrentQueueIndex();
-                    if (index) {
-                        if (index < mediaStatus.items.length - 1) {
+                    if (index != -1) {
+                        if (index < queue.length - 1) {
                             // Play the next item.
-                            loadItem(mediaStatus.items[index++]).catch(handleSetupError);
+                            loadItem(queue.get(index + 1)).catch(handleSetupError);
                         } else {
                             // Recycle through the queue.
-                            loadItem(mediaStatus.items[0]).catch(handleSetupError);
+                            loadItem(queue.get(0)).catch(handleSetupError);
                         }
                     }
                     break;
@@ -1119,30 +1821,23 @@ export default function JWMediaManager(receiverManager, container, events, analy
                     break;
                 case RepeatMode.REPEAT_ALL_AND_SHUFFLE:
                     index = getCurrentQueueIndex();
-                    if (index) {
-                        if (index < mediaStatus.items.length - 1) {
-                            loadItem(mediaStatus.items[index++]).catch(handleSetupError);
+                    if (index != -1) {
+                        if (index < queue.length - 1) {
+                            loadItem(queue.get(index + 1)).catch(handleSetupError);
                         } else {
                             // Shuffle time!
-                            n = mediaStatus.items.length;
-
-                            // Shuffle the queue using Fisher-Yates (O(n)):
-                            while (n) {
-                                // Pick a remaining element.
-                                i = Math.floor(Math.random() * n--);
-
-                                // Swap it with the current element.
-                                temp = mediaStatus.items[n];
-                                mediaStatus.items[n] = mediaStatus.items[i];
-                                mediaStatus.items[i] = temp;
-                            }
+                            queue.shuffle();
+                            // Every item moved to the end in the new order,
+                            // which is how a sender can apply the shuffle.
+                            broadcastQueueChange({}, QueueChangeType.UPDATE,
+                                queue.toArray().map(item => item.itemId));
 
                             // Play the first item.
-                            loadItem(mediaStatus.items[0]).catch(handleSetupError);
+                            loadItem(queue.get(0)).catch(handleSetupError);
 
                             // Make sure to push the updated queue to connected
                             // senders.
-                            // mediaStatusFlags.push(MediaStatusFlags.QUEUE);
+                            setStatusFlag(MediaStatusFlags.QUEUE);
                         }
                     }
                     break;
@@ -1185,33 +1880,46 @@ export default function JWMediaManager(receiverManager, container, events, analy
     }
 
     function registerPlayerStateListeners() {
-        playerInstance.on('buffer', () => {
+        playerListeners.on('buffer', () => {
             updatePlayerState('buffer', false);
         });
-        playerInstance.on('idle', () => {
+        playerListeners.on('idle', () => {
             updatePlayerState('idle', false);
         });
-        playerInstance.on('pause', () => {
+        playerListeners.on('pause', () => {
             updatePlayerState('pause', false);
         });
-        playerInstance.on('play', () => {
+        playerListeners.on('play', () => {
             updatePlayerState('play', false);
         });
-        playerInstance.on('time', handleTime);
-        playerInstance.on('error', handleMediaError);
-        playerInstance.on('mediaError', handleMediaError);
-        playerInstance.on('complete', handleComplete);
-        playerInstance.on('captionsList', handleCaptions);
-        playerInstance.on('audioTracks', handleAudioTracks);
-        playerInstance.on('playlistItem', (playlistItem) => {
+        playerListeners.on('time', handleTime);
+        playerListeners.on('error', handleMediaError);
+        playerListeners.on('mediaError', handleMediaError);
+        playerListeners.on('complete', handleComplete);
+        playerListeners.on('captionsList', handleCaptions);
+        playerListeners.on('audioTracks', handleAudioTracks);
+        playerListeners.on('playlistItem', (playlistItem) => {
             events.publish(Events.MEDIA_LOADED, {
                 media: mediaStatus.media,
                 playlistItem: playlistItem
             });
         });
-        playerInstance.on('seek', event => events.publish(Events.MEDIA_SEEK, event));
-        playerInstance.on('seeked', () => {
+        playerListeners.on('seek', event => events.publish(Events.MEDIA_SEEK, event));
+        playerListeners.on('seeked', () => {
             events.publish(Events.MEDIA_SEEKED, {});
+            handleSeeked();
+        });
+        playerListeners.on('captionsChanged', event => {
+            if (updateActiveCaptions(event)) {
+                broadcastStatus();
+            }
+            completeRequests(Completion.TRACKS);
+        });
+        playerListeners.on('audioTrackChanged', event => {
+            if (updateActiveAudioTrack(event)) {
+                broadcastStatus();
+            }
+            completeRequests(Completion.TRACKS);
         });
         // googima doesn't fire adMeta events, thus we use the adImpression event
         // to trigger the handler.
@@ -1219,117 +1927,350 @@ export default function JWMediaManager(receiverManager, container, events, analy
             && mediaStatus.media.customData.advertising) {
             let advertising = mediaStatus.media.customData.advertising;
             if (advertising.client === 'vast') {
-                playerInstance.on('adMeta', handleAdMeta);
+                playerListeners.on('adMeta', handleAdMeta);
             } else if (advertising.client === 'googima') {
-                playerInstance.on('adImpression', handleAdImpression);
+                playerListeners.on('adImpression', handleAdImpression);
             }
         }
-        playerInstance.on('adPlay', event => {
+        playerListeners.on('adPlay', event => {
             updatePlayerState('play', true);
             events.publish(Events.AD_PLAY, event);
         });
-        playerInstance.on('adPause', event => {
+        playerListeners.on('adPause', event => {
             updatePlayerState('pause', true);
             events.publish(Events.AD_PAUSE, event);
         });
-        playerInstance.on('adComplete', handleAdComplete);
-        playerInstance.on('adError', event => {
+        playerListeners.on('adComplete', handleAdComplete);
+        playerListeners.on('adError', event => {
             console.error('AdError: %O', event);
             events.publish(Events.AD_ERROR, event);
             delete mediaStatus.customData.adMeta;
             delete mediaStatus.breakStatus;
             broadcastStatus();
         });
-        playerInstance.on('adTime', handleAdTime);
+        playerListeners.on('adTime', handleAdTime);
     }
 
     function removeStateListeners() {
-        playerInstance.off('buffer');
-        playerInstance.off('idle');
-        playerInstance.off('pause');
-        playerInstance.off('play');
-        playerInstance.off('time');
-        playerInstance.off('error');
-        playerInstance.off('mediaError');
-        playerInstance.off('complete');
-        playerInstance.off('captionsList');
-        playerInstance.off('audioTracks');
-        playerInstance.off('adMeta');
-        playerInstance.off('adComplete');
-        playerInstance.off('adError');
-        playerInstance.off('adImpression');
-    }
-
-    function serializeStatus(requestId) {
-        updateActiveTracks();
-
-        let statusCopy;
+        if (playerListeners) {
+            playerListeners.removeAll();
+            playerListeners = null;
+        }
+    }
+
+    /**
+     * Flags an element of the media status as changed, so that it will be
+     * serialized with the next broadcast.
+     * @param {MediaStatusFlags} flag The element that changed.
+     */
+    function setStatusFlag(flag) {
+        if (mediaStatusFlags.indexOf(flag) < 0) {
+            mediaStatusFlags.push(flag);
+        }
+        mediaStatusVersion++;
+        statusSnapshots = {};
+        fragmentRevisions[flag] = (fragmentRevisions[flag] || 0) + 1;
+        if (flag == MediaStatusFlags.META) {
+            // Queue items embed the media they refer to.
+            fragmentRevisions[MediaStatusFlags.QUEUE] = (fragmentRevisions[MediaStatusFlags.QUEUE] || 0) + 1;
+        }
+    }
+
+    /**
+     * Returns the serialized JSON of an element of the media status,
+     * serializing it only if it changed since the last time.
+     * @param {string} name The name of the element, see MediaStatusFlags.
+     * @param {*} value The current value of the element.
+     */
+    function getStatusFragment(name, value) {
+        let revision = fragmentRevisions[name] || 0;
+        let fragment = fragmentCache[name];
+        if (!fragment || fragment.value !== value || fragment.revision !== revision) {
+            fragment = {
+                value: value,
+                revision: revision,
+                json: JSON.stringify(value)
+            };
+            fragmentCache[name] = fragment;
+        }
+        return fragment.json;
+    }
+
+    /**
+     * Serializes the media status to a MEDIA_STATUS message.
+     * @param {number} requestId The requestId to associate with the status.
+     * @param {Array<MediaStatusFlags>} elements The elements to serialize,
+     * defaults to the elements that have been flagged.
+     * @return {string} The JSON of the message.
+     */
+    function serializeStatus(requestId, elements) {
+        return createStatusMessage(serializeStatusBody(elements), requestId);
+    }
+
+    /**
+     * Serializes the media status, without the message envelope.
+     * @param {Array<MediaStatusFlags>} elements The elements to serialize,
+     * defaults to the elements that have been flagged.
+     * @return {string} The JSON of the status, or '' without a media session.
+     */
+    function serializeStatusBody(elements) {
+        elements = elements || mediaStatusFlags;
+
+        let statusJson = '';
         if (mediaStatus) {
-            statusCopy = Object.assign({}, mediaStatus);
+            let statusCopy = Object.assign({}, mediaStatus);
+            if (queue) {
+                statusCopy.items = queue.toArray();
+            }
 
-            // Delete properties we don't want to send.
-            // for (let flag in MediaStatusFlags) {
-            //   if (MediaStatusFlags.hasOwnProperty(flag)
-            //     && mediaStatusFlags.indexOf(flag) < 0) {
-            //     delete statusCopy[MediaStatusFlags[flag]];
-            //     mediaStatusFlags.splice(mediaStatusFlags.indexOf(flag), 1);
-            //   }
-            // }
+            // Take out the flagged elements, these are joined in
+            // from their cached fragments if we want to send them.
+            // Concatenation, unlike Array.join(), does not copy them.
+            let fragments = '';
+            for (let flag in MediaStatusFlags) {
+                if (MediaStatusFlags.hasOwnProperty(flag)) {
+                    let name = MediaStatusFlags[flag];
+                    if (statusCopy[name] !== undefined && elements.indexOf(name) >= 0) {
+                        let fragment = getStatusFragment(name, statusCopy[name]);
+                        // Leave out queues that would not fit in a message,
+                        // senders can page through those.
+                        if (name != MediaStatusFlags.QUEUE || fragment.length <= maxStatusQueueSize) {
+                            fragments += `,"${name}":${fragment}`;
+                        }
+                    }
+                    delete statusCopy[name];
+                }
+            }
+
+            statusCopy.customData = Object.assign({}, mediaStatus.customData, {
+                statusVersion: mediaStatusVersion
+            });
 
             if (!statusCopy.activeTrackIds) {
                 delete statusCopy.activeTrackIds;
             }
+
+            // statusCopy always contains customData, so the fragments
+            // can be appended after a comma.
+            statusJson = JSON.stringify(statusCopy);
+            if (fragments) {
+                statusJson = `${statusJson.slice(0, -1)}${fragments}}`;
+            }
         }
 
-        let status = {
+        return statusJson;
+    }
+
+    /**
+     * Wraps a serialized status in a MEDIA_STATUS message.
+     * @param {string} statusJson The serialized status.
+     * @param {number} requestId The requestId to associate with the status.
+     * @param {Array<number>} completedRequestIds All requests that are
+     * acknowledged by the message, if there are several.
+     * @return {string} The JSON of the message.
+     */
+    function createStatusMessage(statusJson, requestId, completedRequestIds) {
+        let envelope = {
             type: MessageType.MEDIA_STATUS,
-            requestId: requestId ? requestId : currentRequestId,
-            status: statusCopy ? [statusCopy] : []
+            requestId: requestId ? requestId : 0
         };
-        // Always reset the requestId after a message has been sent with it.
-        currentRequestId = 0;
-        return status;
+        if (completedRequestIds) {
+            envelope.completedRequestIds = completedRequestIds;
+        }
+        let status = JSON.stringify(envelope);
+        return `${status.slice(0, -1)},"status":[${statusJson}]}`;
+    }
+
+    /**
+     * Schedules a status broadcast.
+     *
+     * Status changes made in the same task are coalesced into a single
+     * status update, which is sent in a microtask. The update acknowledges
+     * the requests that have been completed by then.
+     */
+    function broadcastStatus() {
+        statusSnapshots = {};
+        if (isLoading) {
+            return;
+        }
+        broadcastStats.requested++;
+
+        if (pendingBroadcast) {
+            // Merge this broadcast into the pending one.
+            broadcastStats.coalesced++;
+            return;
+        }
+        pendingBroadcast = true;
+        Promise.resolve().then(flushBroadcast);
     }
 
-    function broadcastStatus(requestId) {
+    /**
+     * Completes the requests that wait for the given condition, and
+     * acknowledges them with a status update.
+     * @param {Completion} condition The condition that has been met.
+     * @param {boolean} merge Whether to acknowledge them in a single update.
+     */
+    function completeRequests(condition, merge) {
+        if (pendingRequests.complete(condition, merge)) {
+            broadcastStatus();
+        }
+    }
+
+    /**
+     * Sends the pending status broadcast, if any.
+     *
+     * The status is serialized once, and broadcast without a requestId.
+     * requestIds are only unique per sender, so completed requests are
+     * acknowledged with a message to their sender, which carries its own
+     * requestId. Requests of a sender that have been completed together (or
+     * all of them, if mergeCompletedRequests has been configured) share a
+     * single message, which carries the latest requestId and lists all of
+     * them in completedRequestIds.
+     */
+    function flushBroadcast() {
+        if (!pendingBroadcast) {
+            return;
+        }
+        pendingBroadcast = false;
         if (isLoading) {
             return;
         }
-        broadcastMessage(serializeStatus(requestId));
+        let statusJson = serializeStatusBody();
+        groupAcknowledgements(pendingRequests.takeCompleted()).forEach(requests => {
+            let senderId = requests[0].senderId;
+            let requestIds = requests.map(request => request.requestId);
+            let status = createStatusMessage(statusJson, requestIds[requestIds.length - 1],
+                requestIds.length > 1 ? requestIds : undefined);
+            requests.forEach(request => requestCache.setReply(senderId, request.requestId, status));
+            sendMessage(senderId, status);
+            broadcastStats.acknowledgements++;
+        });
+        broadcastMessage(createStatusMessage(statusJson, 0));
+        broadcastStats.sent++;
+        // Every sender is up to date now.
+        mediaStatusFlags = [];
+    }
+
+    /**
+     * Splits groups of completed requests per sender, and merges the groups
+     * of each sender if mergeCompletedRequests has been configured.
+     * @param {Array<Array<{senderId: string, requestId: number}>>} groups
+     * The groups of completed requests.
+     * @return {Array<Array<{senderId: string, requestId: number}>>} Groups
+     * of requests of a single sender.
+     */
+    function groupAcknowledgements(groups) {
+        let acknowledgements = [];
+        let merged = {};
+        groups.forEach(group => {
+            let groupBySender = {};
+            group.forEach(request => {
+                let bySender = mergeCompletedRequests ? merged : groupBySender;
+                let requests = bySender[request.senderId];
+                if (!requests) {
+                    requests = bySender[request.senderId] = [];
+                    acknowledgements.push(requests);
+                }
+                requests.push(request);
+            });
+        });
+        return acknowledgements;
     }
 
-    function sendStatus(senderId, requestId) {
+    function sendStatus(senderId, requestId, elements) {
         if (isLoading) {
             return;
         }
-        let status = serializeStatus(requestId);
+        let status = serializeStatus(requestId, elements);
+        requestCache.setReply(senderId, requestId, status);
         sendMessage(senderId, status);
     }
 
+    /**
+     * Answers a GET_STATUS request.
+     *
+     * GET_STATUS requests that arrive within STATUS_COLLAPSE_WINDOW share a
+     * single serialization of the status, as long as it does not change.
+     * Senders that are over their rate limit get the last serialization
+     * regardless of its age, only its currentTime can be outdated.
+     * Every requester gets a message with its own requestId, also while
+     * loading, when the status describes the media session being loaded.
+     */
+    function sendRequestedStatus(senderId, requestId, elements, limited) {
+        senderLimiter.count(senderId, 'statusRequests');
+        let key = elements.join();
+        let snapshot = statusSnapshots[key];
+        let now = Date.now();
+        if (snapshot && (limited || now - snapshot.time < STATUS_COLLAPSE_WINDOW)) {
+            senderLimiter.count(senderId, 'statusCollapsed');
+        } else {
+            snapshot = {
+                time: now,
+                json: serializeStatusBody(elements)
+            };
+            statusSnapshots[key] = snapshot;
+        }
+        sendMessage(senderId, createStatusMessage(snapshot.json, requestId));
+    }
+
+    /**
+     * Notifies senders of a change in the queue.
+     * @param {Object} event The event that caused the change.
+     * @param {QueueChangeType} changeType The type of change.
+     * @param {Array<number>} itemIds The ids of the affected items.
+     * @param {number} insertBefore The itemId the items have been inserted before.
+     */
+    function broadcastQueueChange(event, changeType, itemIds, insertBefore) {
+        let message = {
+            type: MessageType.QUEUE_CHANGE,
+            requestId: event.data && event.data.requestId ? event.data.requestId : 0,
+            changeType: changeType,
+            itemIds: itemIds
+        };
+        if (insertBefore) {
+            message.insertBefore = insertBefore;
+        }
+        broadcastMessage(message);
+    }
+
     function sendErrorInvalidRequest(event, reason) {
         sendError(MessageType.INVALID_REQUEST, reason, event);
     }
 
     function sendErrorInvalidPlayerState(event) {
-        broadcastMessage({
-            requestId: event.requestId ? event.requestId : 0,
-            type: MessageType.INVALID_PLAYER_STATE,
-        });
+        pendingRequests.remove(event.senderId, event.data.requestId);
+        broadcastMessage(createErrorMessage(event, {
+            type: MessageType.INVALID_PLAYER_STATE
+        }));
     }
 
     function sendErrorLoadCancelled(event) {
-        broadcastMessage({
-            requestId: event.requestId ? event.requestId : 0,
+        // Only the sender of the cancelled request needs to know.
+        sendMessage(event.senderId, createErrorMessage(event, {
             type: MessageType.LOAD_CANCELLED
-        });
+        }));
     }
 
     function sendError(messageType, reason, event) {
-        broadcastMessage({
-            requestId: event.requestId ? event.requestId : 0,
+        pendingRequests.remove(event.senderId, event.data.requestId);
+        broadcastMessage(createErrorMessage(event, {
             type: messageType,
             reason: reason
-        });
+        }));
+    }
+
+    /**
+     * Serializes an error reply to a request, and stores it in the
+     * request cache.
+     * @return {string} The JSON of the message.
+     */
+    function createErrorMessage(event, error) {
+        let requestId = event.data.requestId ? event.data.requestId : 0;
+        let message = JSON.stringify(Object.assign({
+            requestId: requestId
+        }, error));
+        requestCache.setReply(event.senderId, requestId, message);
+        return message;
     }
 
     /**
@@ -1340,6 +2281,9 @@ export default function JWMediaManager(receiverManager, container, events, analy
             playerInstance.stop();
             removeStateListeners();
         }
+        cancelPreload();
+        // Requests that wait for the player can no longer complete.
+        pendingRequests.clear().forEach(request => requestCache.forget(request.senderId, request.requestId));
 
         let mediaSessionId = mediaStatus ? mediaStatus.mediaSessionId += 1 : 1;
         mediaStatus = new cast.receiver.media.MediaStatus();
@@ -1347,51 +2291,14 @@ export default function JWMediaManager(receiverManager, container, events, analy
         mediaStatus.supportedMediaCommands = SUPPORTED_FEATURES;
         mediaStatus.mediaSessionId = mediaSessionId;
         mediaStatus.customData = {};
+        queue = null;
     }
 
     function getCurrentQueueIndex() {
-        return findIndexOfItem(mediaStatus.currentItemId);
-    }
-
-    function findIndexOfItem(itemId) {
-        let itemIndex = -1;
-        if (!itemId || !mediaStatus.items
-            || mediaStatus.items.length == 0) {
-            return itemIndex;
-        }
-
-        mediaStatus.items.some((mediaItem, index) => {
-            if (itemId == mediaItem.itemId) {
-                itemIndex = index;
-                return true;
-            }
-        });
-        return itemIndex;
-    }
-
-    function getTrackIndex(trackId) {
-        let trackIndex = -1;
-        if (!trackId || !mediaStatus.media.tracks
-            || mediaStatus.media.tracks.length == 0) {
-            return trackIndex;
-        }
-
-        mediaStatus.media.tracks.some((track, index) => {
-            if (trackId == track.trackId) {
-                trackIndex = index;
-                return true;
-            }
-            return false;
-        });
-        return trackIndex;
-    }
-
-    function getTrackById(trackId) {
-        let trackIndex = getTrackIndex(trackId);
-        if (trackIndex < 0) {
-            return null;
+        if (!queue || !mediaStatus.currentItemId) {
+            return -1;
         }
-        return mediaStatus.media.tracks[trackIndex];
+        return queue.indexOf(mediaStatus.currentItemId);
     }
 
     // Converts a Chromecast Media Object into a JW Player playlist.
@@ -1441,118 +2348,49 @@ export default function JWMediaManager(receiverManager, container, events, analy
         return [playlistItem];
     }
 
-    function offsetTime(offset, duration) {
-        if (offset.toString().slice(-1) === '%') {
-            return duration * Number.parseFloat(offset.slice(0, -1)) / 100;
-        }
-        return Number.parseFloat(offset);
-    }
-
-    // Parses Ad Breaks from the customData section of a MediaInfo object.
-    function parseBreaksFromMediaInfo(media) {
-        let adBreaks = [];
-        if (!media.customData || !media.customData.advertising
-            || !media.customData.advertising.schedule) {
-            return adBreaks;
-        }
-        let adSchedule = media.customData.advertising.schedule;
-        Object.keys(adSchedule).forEach(breakId => {
-            let adBreak = adSchedule[breakId];
-            let breakPosition;
-            if (adBreak.offset == 'pre') {
-                breakPosition = 0;
-            } else if (adBreak.offset == 'post') {
-                breakPosition = media.duration;
-            } else {
-                breakPosition = adBreak.offset.indexOf(':') != -1 ?
-                jwplayer.utils.seconds(adBreak.offset) : offsetTime(adBreak.offset, media.duration);
-            }
-            adBreaks.push(new AdBreakInfo(breakId, breakPosition));
-        });
-        return adBreaks;
-    }
-
     /**
-     * Initializes the "breaks" property in a MediaInfo object.
+     * Compiles the ad schedule of an item into the ad timeline, and
+     * initializes the "breaks" property in its MediaInfo object.
      */
-    function initAdBreakInfo(media) {
-        // Update information about adBreaks in the MediaInfo object.
-        let breaks = parseBreaksFromMediaInfo(media);
-        if (breaks.length > 0) {
-            media.breaks = breaks;
-        } else {
-            delete media.breaks;
+    function initAdTimeline(media) {
+        let schedule = media.customData && media.customData.advertising
+            && media.customData.advertising.schedule;
+        adTimeline = schedule ? new ads.AdTimeline(schedule) : null;
+        if (adTimeline) {
+            adTimeline.setDuration(media.duration);
         }
         // Delete breakClips until we have determined them.
         delete media.breakClips;
+        updateAdBreakInfo();
     }
 
     /**
-     * Generates a new unique trackId.
+     * Points the "breaks" and "breakClips" properties of the current
+     * MediaInfo object to the ad timeline.
      */
-    function generateTrackId() {
-        let trackId = 1;
-        // Find the highest trackId in mediaStatus.media.tracks and start numbering from that.
-        mediaStatus.media.tracks.forEach(track => {
-            if (track.trackId >= trackId) {
-                trackId = track.trackId++;
-            }
-        });
-        return trackId;
+    function updateAdBreakInfo() {
+        let media = mediaStatus.media;
+        if (adTimeline && adTimeline.breaks.length > 0) {
+            media.breaks = adTimeline.breaks;
+        } else {
+            delete media.breaks;
+        }
+        if (adTimeline && adTimeline.clips.length > 0) {
+            media.breakClips = adTimeline.clips;
+        }
+        setStatusFlag(MediaStatusFlags.META);
     }
 
     /**
-     * Synchronizes the activeTrackIds array in the media session with
-     * what is active on the JW Player instance.
+     * Updates the duration of the current item, which positions the ad
+     * breaks that depend on it (e.g. postrolls & ads with a percentual offset).
      */
-    function updateActiveTracks() {
-        if (!mediaStatus) {
-            // No active media session.
-            return false;
-        }
-
-        let activeTrackIds = [];
-        if (!playerInstance) {
-            mediaStatus.activeTrackIds = activeTrackIds;
-            return false;
+    function updateDuration(duration) {
+        mediaStatus.media.duration = duration;
+        setStatusFlag(MediaStatusFlags.META);
+        if (adTimeline && adTimeline.setDuration(duration)) {
+            updateAdBreakInfo();
         }
-
-        // Caption Tracks
-        let activeCaptionTrackIndex = playerInstance.getCurrentCaptions();
-        if (activeCaptionTrackIndex > 0) {
-            // Player has captions enabled.
-            let activeCaptionTrack = playerInstance.getCaptionsList()[activeCaptionTrackIndex];
-            // Find the associated track in mediaStatus.media.tracks:
-            mediaStatus.media.tracks.some(track => {
-                if (track.type == TrackType.TEXT
-            && track.trackContentId == activeCaptionTrack.id) {
-                    activeTrackIds.push(track.trackId);
-                    return true;
-                }
-            });
-        }
-
-        // Audio Tracks
-        let activeAudioTrack = playerInstance.getCurrentAudioTrack();
-        // -1 = no alternative tracks
-        if (activeAudioTrack >= 0) {
-            mediaStatus.media.tracks.some(track => {
-                if (track.type == TrackType.AUDIO
-            && track.trackContentId == activeAudioTrack) {
-                    activeTrackIds.push(track.trackId);
-                    return true;
-                }
-            });
-        }
-
-        // TODO: Video Tracks
-
-        // Check whether the activeTracks were updated.
-        let activeTracksChanged = mediaStatus.activeTrackIds.length != activeTrackIds.length
-            || mediaStatus.activeTrackIds.some(trackId => activeTrackIds.indexOf(trackId) < 0);
-        // Update the media session.
-        mediaStatus.activeTrackIds = activeTrackIds;
-        return activeTracksChanged;
     }
 
     /**
@@ -1560,27 +2398,30 @@ export default function JWMediaManager(receiverManager, container, events, analy
      */
     function getNextItemInQueue() {
         let index = -1;
+        if (!mediaStatus || !queue) {
+            return null;
+        }
 
         // TODO: can we get rid of the duplicated logic here?
         // maybe merge with handleComplete?
         // Is there a better way of exposing this?
         switch (mediaStatus.repeatMode) {
             case RepeatMode.REPEAT_OFF:
-                return mediaStatus.items.length >= 2 ? mediaStatus.items[1] : null;
+                return queue.length >= 2 ? queue.get(1) : null;
             case RepeatMode.REPEAT_ALL:
                 index = getCurrentQueueIndex();
                 if (index != -1) {
-                    return index == mediaStatus.items.length - 1
-                        ? mediaStatus.items[0] : mediaStatus.items[index++];
+                    return index == queue.length - 1
+                        ? queue.get(0) : queue.get(index + 1);
                 }
                 return null;
             case RepeatMode.REPEAT_SINGLE:
-                return mediaStatus.items[getCurrentQueueIndex()];
+                return queue.getById(mediaStatus.currentItemId) || null;
             case RepeatMode.REPEAT_ALL_AND_SHUFFLE:
                 index = getCurrentQueueIndex();
                 if (index != -1) {
-                    return index == mediaStatus.items.length - 1
-                        ? null : mediaStatus.items[index++];
+                    return index == queue.length - 1
+                        ? null : queue.get(index + 1);
                 }
                 break;
             default:
@@ -1611,6 +2452,70 @@ export default function JWMediaManager(receiverManager, container, events, analy
                     items: [mediaQueueItem]
                 }
             });
+        },
+
+        /**
+         * Returns the time to first frame per load path
+         * ('setup', 'load' or 'preload'), in milliseconds.
+         */
+        getLoadStats: function() {
+            return JSON.parse(JSON.stringify(loadStats));
+        },
+
+        /**
+         * Returns the number of requested, sent and coalesced status broadcasts,
+         * and the number of acknowledgements sent to the requesting senders.
+         */
+        getBroadcastStats: function() {
+            return Object.assign({}, broadcastStats);
+        },
+
+        /**
+         * Enables or disables MEDIA_TIME events, e.g. while the progress
+         * is hidden.
+         */
+        setTimeDisplayEnabled: function(enabled) {
+            timePipeline.setDisplayEnabled(enabled);
+        },
+
+        /**
+         * Returns the number of time updates and published time events.
+         */
+        getTimeStats: function() {
+            return timePipeline.getStats();
+        },
+
+        /**
+         * Returns the number of retried (hits) and new (misses) requests.
+         */
+        getRequestCacheStats: function() {
+            return requestCache.getStats();
+        },
+
+        /**
+         * Returns the number of SEEK requests, the number of seeks that
+         * have been applied, and the seek-to-playing latency of bursts
+         * of seeks, in milliseconds.
+         */
+        getSeekStats: function() {
+            return Object.assign({}, seekStats);
+        },
+
+        /**
+         * Returns the number of requests, limited requests, GET_STATUS
+         * requests and GET_STATUS requests that shared a serialization,
+         * per senderId.
+         */
+        getSenderStats: function() {
+            return senderLimiter.getStats();
+        },
+
+        /**
+         * Returns the number of commands and their queueing delay in
+         * milliseconds, per class of command.
+         */
+        getSchedulerStats: function() {
+            return commandScheduler.getStats();
         }
     };
 }
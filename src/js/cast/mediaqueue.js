@@ -0,0 +1,378 @@
+/**
+ * A node in the MediaQueue tree.
+ */
+class QueueNode {
+
+    constructor(item) {
+        this.item = item;
+        this.priority = Math.random();
+        this.size = 1;
+        this.left = null;
+        this.right = null;
+        this.parent = null;
+    }
+
+}
+
+function sizeOf(node) {
+    return node ? node.size : 0;
+}
+
+/**
+ * Recalculates the size of a node and re-parents its children.
+ */
+function update(node) {
+    node.size = 1 + sizeOf(node.left) + sizeOf(node.right);
+    if (node.left) {
+        node.left.parent = node;
+    }
+    if (node.right) {
+        node.right.parent = node;
+    }
+}
+
+/**
+ * Joins two trees, all nodes of left will end up before the nodes of right.
+ */
+function merge(left, right) {
+    if (!left) {
+        return right;
+    }
+    if (!right) {
+        return left;
+    }
+    if (left.priority > right.priority) {
+        left.right = merge(left.right, right);
+        update(left);
+        return left;
+    }
+    right.left = merge(left, right.left);
+    update(right);
+    return right;
+}
+
+/**
+ * Splits a tree in two, the first tree contains the first count nodes.
+ */
+function split(node, count) {
+    if (!node) {
+        return [null, null];
+    }
+    let parts;
+    if (sizeOf(node.left) >= count) {
+        parts = split(node.left, count);
+        node.left = parts[1];
+        update(node);
+        return [parts[0], node];
+    }
+    parts = split(node.right, count - sizeOf(node.left) - 1);
+    node.right = parts[0];
+    update(node);
+    return [node, parts[1]];
+}
+
+/**
+ * Builds a tree out of an array of nodes in O(n), keeping their order.
+ */
+function build(nodes) {
+    // Build a cartesian tree on the node priorities.
+    let stack = [];
+    nodes.forEach(node => {
+        let last = null;
+        while (stack.length && stack[stack.length - 1].priority < node.priority) {
+            last = stack.pop();
+        }
+        node.left = last;
+        node.right = null;
+        if (stack.length) {
+            stack[stack.length - 1].right = node;
+        }
+        stack.push(node);
+    });
+
+    let root = stack.length ? stack[0] : null;
+    if (root) {
+        root.parent = null;
+        // Nodes have been linked up, now fix the sizes bottom-up.
+        let order = [root];
+        for (let i = 0; i < order.length; i++) {
+            let node = order[i];
+            if (node.left) {
+                order.push(node.left);
+            }
+            if (node.right) {
+                order.push(node.right);
+            }
+        }
+        for (let i = order.length - 1; i >= 0; i--) {
+            update(order[i]);
+        }
+    }
+    return root;
+}
+
+/**
+ * The queue of a media session.
+ *
+ * Items are kept in an implicit treap, together with an itemId to node index.
+ * This allows for looking up the position of an item, and for inserting,
+ * removing and moving items at any position in O(log n).
+ * Batches of items are built into a tree in a single pass before they are
+ * joined with the queue.
+ *
+ * @param {Array<MediaQueueItem>} items The initial items of the queue.
+ */
+export default class MediaQueue {
+
+    constructor(items) {
+        this.nodes = new Map();
+        this.nextItemId = 1;
+        this.cachedItems = null;
+        this.root = build(this.createNodes(items || []));
+    }
+
+    /**
+     * The number of items in the queue.
+     */
+    get length() {
+        return sizeOf(this.root);
+    }
+
+    /**
+     * Allocates a new unique itemId.
+     */
+    allocateItemId() {
+        return this.nextItemId++;
+    }
+
+    /**
+     * Numbers the given items and creates nodes for them.
+     */
+    createNodes(items) {
+        return items.map(item => {
+            item.itemId = this.allocateItemId();
+            let node = new QueueNode(item);
+            this.nodes.set(item.itemId, node);
+            return node;
+        });
+    }
+
+    /**
+     * Returns whether an item is in the queue.
+     */
+    has(itemId) {
+        return this.nodes.has(itemId);
+    }
+
+    /**
+     * Returns the item with the given itemId, or undefined.
+     */
+    getById(itemId) {
+        let node = this.nodes.get(itemId);
+        return node ? node.item : undefined;
+    }
+
+    /**
+     * Returns the item at the given index, or undefined.
+     */
+    get(index) {
+        if (!(index >= 0 && index < this.length)) {
+            return undefined;
+        }
+        let node = this.root;
+        while (node) {
+            let leftSize = sizeOf(node.left);
+            if (index < leftSize) {
+                node = node.left;
+            } else if (index == leftSize) {
+                return node.item;
+            } else {
+                index -= leftSize + 1;
+                node = node.right;
+            }
+        }
+        return undefined;
+    }
+
+    /**
+     * Returns the index of the item with the given itemId, or -1.
+     */
+    indexOf(itemId) {
+        let node = this.nodes.get(itemId);
+        if (!node) {
+            return -1;
+        }
+        let index = sizeOf(node.left);
+        while (node.parent) {
+            if (node.parent.right === node) {
+                index += sizeOf(node.parent.left) + 1;
+            }
+            node = node.parent;
+        }
+        return index;
+    }
+
+    /**
+     * Inserts items before the item with itemId insertBefore, or at the end
+     * of the queue if it is not specified or could not be found.
+     * The items will be assigned a new itemId.
+     *
+     * @return {Array<number>} The itemIds of the inserted items.
+     */
+    insert(items, insertBefore) {
+        let inserted = build(this.createNodes(items));
+        this.insertTree(inserted, insertBefore);
+        return items.map(item => item.itemId);
+    }
+
+    /**
+     * Removes the items with the given itemIds from the queue.
+     *
+     * @return {Array<number>} The itemIds that have been removed.
+     */
+    remove(itemIds) {
+        return itemIds.filter(itemId => {
+            let node = this.nodes.get(itemId);
+            if (!node) {
+                return false;
+            }
+            this.detach(node);
+            this.nodes.delete(itemId);
+            return true;
+        });
+    }
+
+    /**
+     * Removes the first item of the queue and returns it.
+     */
+    shift() {
+        let item = this.get(0);
+        if (item) {
+            this.remove([item.itemId]);
+        }
+        return item;
+    }
+
+    /**
+     * Moves the items with the given itemIds, in the given order, before
+     * the item with itemId insertBefore, or to the end of the queue if it
+     * is not specified.
+     *
+     * @return {Array<number>} The itemIds that have been moved.
+     */
+    reorder(itemIds, insertBefore) {
+        let moved = [];
+        itemIds.forEach(itemId => {
+            let node = this.nodes.get(itemId);
+            if (node && node.parent !== undefined) {
+                this.detach(node);
+                // Mark the node as detached, to skip duplicate itemIds.
+                node.parent = undefined;
+                moved.push(node);
+            }
+        });
+        let movedIds = moved.map(node => node.item.itemId);
+        if (movedIds.indexOf(insertBefore) >= 0) {
+            // Can't insert before an item that is being moved.
+            insertBefore = undefined;
+        }
+        this.insertTree(build(moved), insertBefore);
+        return movedIds;
+    }
+
+    /**
+     * Shuffles the queue using Fisher-Yates (O(n)).
+     */
+    shuffle() {
+        let nodes = [];
+        this.forEachNode(node => nodes.push(node));
+        let n = nodes.length;
+        while (n) {
+            // Pick a remaining element.
+            let i = Math.floor(Math.random() * n--);
+
+            // Swap it with the current element.
+            let temp = nodes[n];
+            nodes[n] = nodes[i];
+            nodes[i] = temp;
+        }
+        this.root = build(nodes);
+        this.cachedItems = null;
+    }
+
+    /**
+     * Returns the items of the queue as an array.
+     *
+     * The array is cached until the queue changes, it should not be modified.
+     */
+    toArray() {
+        if (!this.cachedItems) {
+            let items = [];
+            this.forEachNode(node => items.push(node.item));
+            this.cachedItems = items;
+        }
+        return this.cachedItems;
+    }
+
+    /**
+     * Calls callback for every node in queue order.
+     */
+    forEachNode(callback) {
+        let stack = [];
+        let node = this.root;
+        while (node || stack.length) {
+            while (node) {
+                stack.push(node);
+                node = node.left;
+            }
+            node = stack.pop();
+            callback(node);
+            node = node.right;
+        }
+    }
+
+    /**
+     * Joins a tree with the queue before the item with itemId insertBefore.
+     */
+    insertTree(tree, insertBefore) {
+        if (tree) {
+            let index = insertBefore !== undefined ? this.indexOf(insertBefore) : -1;
+            if (index < 0) {
+                index = this.length;
+            }
+            let parts = split(this.root, index);
+            this.root = merge(merge(parts[0], tree), parts[1]);
+            this.root.parent = null;
+        }
+        this.cachedItems = null;
+    }
+
+    /**
+     * Takes a node out of the tree, keeping the order of the other nodes.
+     */
+    detach(node) {
+        let parent = node.parent;
+        let child = merge(node.left, node.right);
+        if (!parent) {
+            this.root = child;
+        } else if (parent.left === node) {
+            parent.left = child;
+        } else {
+            parent.right = child;
+        }
+        if (child) {
+            child.parent = parent;
+        }
+        // Update the sizes up to the root.
+        while (parent) {
+            parent.size = 1 + sizeOf(parent.left) + sizeOf(parent.right);
+            parent = parent.parent;
+        }
+        node.left = null;
+        node.right = null;
+        node.parent = null;
+        node.size = 1;
+        this.cachedItems = null;
+    }
+
+}
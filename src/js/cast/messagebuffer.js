@@ -0,0 +1,92 @@
+/**
+ * Buffers the messages of a CastMessageBus until the app is ready to
+ * handle them, so that the receiver can be started before the app.
+ *
+ * The buffer can be used in place of the message bus. Messages that arrived
+ * before release() are delivered to the listeners in order of arrival when it
+ * is called, later messages are delivered right away.
+ *
+ * Example Usage:
+ *
+ * let buffer = new MessageBuffer(receiverManager.getCastMessageBus(namespace));
+ * receiverManager.start();
+ * ...
+ * buffer.addEventListener('message', handleMessage);
+ * buffer.release();
+ *
+ * @param {cast.receiver.CastMessageBus} messageBus The message bus to buffer.
+ */
+export default class MessageBuffer {
+
+    constructor(messageBus) {
+        this.messageBus = messageBus;
+        this.messages = [];
+        this.listeners = [];
+        this.released = false;
+        this.messageBus.addEventListener('message', message => this.handleMessage(message));
+    }
+
+    /**
+     * Adds a listener for 'message' events.
+     */
+    addEventListener(type, listener) {
+        if (type == 'message') {
+            this.listeners.push(listener);
+        }
+    }
+
+    /**
+     * Removes a listener for 'message' events.
+     */
+    removeEventListener(type, listener) {
+        let index = this.listeners.indexOf(listener);
+        if (type == 'message' && index >= 0) {
+            this.listeners.splice(index, 1);
+        }
+    }
+
+    broadcast(message) {
+        this.messageBus.broadcast(message);
+    }
+
+    send(senderId, message) {
+        this.messageBus.send(senderId, message);
+    }
+
+    /**
+     * Delivers the buffered messages, and every message that arrives later.
+     */
+    release() {
+        if (this.released) {
+            return;
+        }
+        this.released = true;
+        let messages = this.messages;
+        this.messages = [];
+        messages.forEach(message => this.deliver(message));
+    }
+
+    /**
+     * The number of messages that are waiting for release().
+     */
+    get size() {
+        return this.messages.length;
+    }
+
+    handleMessage(message) {
+        if (this.released) {
+            this.deliver(message);
+        } else {
+            // The bus might reuse its event objects.
+            this.messages.push({
+                senderId: message.senderId,
+                data: message.data
+            });
+        }
+    }
+
+    deliver(message) {
+        this.listeners.forEach(listener => listener(message));
+    }
+
+}
@@ -1,3 +1,6 @@
+import { RepeatMode } from './repeatmode';
+import { TrackType } from './tracktype';
+
 /**
  * Chromecast Event Types
  * Commands senders can send to us over the media channel.
@@ -21,6 +24,9 @@ export const EventType = {
     QUEUE_INSERT: 'QUEUE_INSERT',
     QUEUE_REMOVE: 'QUEUE_REMOVE',
     QUEUE_REORDER: 'QUEUE_REORDER',
+    QUEUE_GET_ITEM_IDS: 'QUEUE_GET_ITEM_IDS',
+    QUEUE_GET_ITEMS: 'QUEUE_GET_ITEMS',
+    QUEUE_GET_ITEM_RANGE: 'QUEUE_GET_ITEM_RANGE',
     PRELOAD: 'PRELOAD',
     CANCEL_PRELOAD: 'CANCEL_PRELOAD'
 };
@@ -58,7 +64,73 @@ export const MessageType = {
      * Broadcasted after a state change or after a media status request.
      * Only the MediaStatus objects that changed or were requested will be sent.
      */
-    MEDIA_STATUS: 'MEDIA_STATUS'
+    MEDIA_STATUS: 'MEDIA_STATUS',
+
+    /**
+     * Sent in reply to QUEUE_GET_ITEM_IDS and QUEUE_GET_ITEM_RANGE requests.
+     */
+    QUEUE_ITEM_IDS: 'QUEUE_ITEM_IDS',
+
+    /**
+     * Sent in reply to QUEUE_GET_ITEMS requests.
+     */
+    QUEUE_ITEMS: 'QUEUE_ITEMS',
+
+    /**
+     * Broadcasted when the queue changes, only contains the affected itemIds.
+     */
+    QUEUE_CHANGE: 'QUEUE_CHANGE'
+};
+
+/**
+ * Types of changes in a QUEUE_CHANGE message.
+ *
+ * @readonly
+ * @enum {string}
+ */
+export const QueueChangeType = {
+    /**
+     * Items have been inserted in the queue.
+     */
+    INSERT: 'INSERT',
+
+    /**
+     * Items have been removed from the queue.
+     */
+    REMOVE: 'REMOVE',
+
+    /**
+     * The content of items changed.
+     */
+    ITEMS_CHANGE: 'ITEMS_CHANGE',
+
+    /**
+     * The order of the queue changed.
+     */
+    UPDATE: 'UPDATE',
+
+    /**
+     * Nothing changed.
+     */
+    NO_CHANGE: 'NO_CHANGE'
+};
+
+/**
+ * Options of a GET_STATUS request, expressed as a summation of the flags.
+ *
+ * @readonly
+ * @enum {number}
+ */
+export const GetStatusOptions = {
+    /**
+     * Do not include the media information in the status.
+     */
+    NO_METADATA: 1,
+
+    /**
+     * Do not include the queue items in the status.
+     */
+    NO_QUEUE_ITEMS: 2
 };
 
 /**
@@ -135,3 +207,127 @@ export const IdleReason = {
      */
     ERROR: 'ERROR'
 };
+
+// Specs that are shared by several schemas.
+const TRACK = {
+    type: 'object',
+    fields: {
+        trackId: { type: 'integer' },
+        type: { type: 'string', values: TrackType },
+        trackContentId: { type: 'string', optional: true },
+        name: { type: 'string', optional: true }
+    }
+};
+
+const AD_BREAK = {
+    type: 'object',
+    fields: {
+        offset: { type: ['string', 'number'], normalize: 'offset' }
+    }
+};
+
+const MEDIA_INFORMATION = {
+    type: 'object',
+    fields: {
+        contentId: { type: 'string' },
+        duration: { type: 'number', optional: true },
+        metadata: { type: 'object', optional: true },
+        tracks: { type: 'array', optional: true, items: TRACK },
+        customData: {
+            type: 'object',
+            optional: true,
+            fields: {
+                advertising: {
+                    type: 'object',
+                    optional: true,
+                    fields: {
+                        // JW Player accepts a map of breaks as well as an array.
+                        schedule: { type: ['object', 'array'], optional: true, entries: AD_BREAK }
+                    }
+                }
+            }
+        }
+    }
+};
+
+const QUEUE_ITEM = {
+    type: 'object',
+    fields: {
+        media: MEDIA_INFORMATION,
+        autoplay: { type: 'boolean', optional: true },
+        startTime: { type: 'number', optional: true, min: 0 },
+        preloadTime: { type: 'number', optional: true, min: 0 }
+    }
+};
+
+const TRACK_IDS = { type: 'array', optional: true, items: { type: 'integer' } };
+const ITEM_ID = { type: 'integer', optional: true };
+const CURRENT_TIME = { type: 'number', optional: true, min: 0 };
+const REPEAT_MODE = { type: 'string', optional: true, values: RepeatMode };
+
+/**
+ * Schemas of the requests that carry parameters, keyed by EventType.
+ *
+ * These are compiled into validator functions at build time, see
+ * validatorcompiler.js. A field spec supports:
+ * - type: 'string', 'number', 'integer', 'boolean', 'object' or 'array',
+ *   or an array of these.
+ * - optional: whether the field may be left out. Optional fields that are
+ *   null are removed, as senders send null for unset fields.
+ * - values: an enum of the allowed values.
+ * - min: the minimum value of a number.
+ * - minItems: the minimum length of an array.
+ * - fields: the specs of the fields of an object.
+ * - items: the spec of the items of an array.
+ * - entries: the spec of the values of an object that is used as a map,
+ *   or of the items of an array.
+ * - normalize: 'offset' parses an ad schedule offset into the non-enumerable
+ *   parsedOffset property of the object that contains it.
+ *
+ * Fields that are not part of a schema are not checked.
+ */
+export const MessageSchema = {
+    [EventType.LOAD]: {
+        media: MEDIA_INFORMATION,
+        autoplay: { type: 'boolean', optional: true },
+        currentTime: CURRENT_TIME,
+        activeTrackIds: TRACK_IDS
+    },
+    [EventType.QUEUE_LOAD]: {
+        items: { type: 'array', minItems: 1, items: QUEUE_ITEM },
+        startIndex: { type: 'integer', optional: true, min: 0 },
+        repeatMode: REPEAT_MODE
+    },
+    [EventType.QUEUE_INSERT]: {
+        items: { type: 'array', minItems: 1, items: QUEUE_ITEM },
+        insertBefore: ITEM_ID,
+        currentItemIndex: { type: 'integer', optional: true, min: 0 },
+        currentItemId: ITEM_ID,
+        currentTime: CURRENT_TIME
+    },
+    [EventType.QUEUE_UPDATE]: {
+        currentItemId: ITEM_ID,
+        jump: { type: 'integer', optional: true },
+        currentTime: CURRENT_TIME,
+        repeatMode: REPEAT_MODE
+    },
+    [EventType.QUEUE_REMOVE]: {
+        itemIds: { type: 'array', minItems: 1, items: { type: 'integer' } },
+        currentItemId: ITEM_ID,
+        currentTime: CURRENT_TIME
+    },
+    [EventType.QUEUE_REORDER]: {
+        itemIds: { type: 'array', minItems: 1, items: { type: 'integer' } },
+        insertBefore: ITEM_ID,
+        currentItemId: ITEM_ID,
+        currentTime: CURRENT_TIME
+    },
+    [EventType.SEEK]: {
+        currentTime: CURRENT_TIME,
+        resumeState: { type: 'string', optional: true, values: SeekResumeState }
+    },
+    [EventType.EDIT_TRACKS_INFO]: {
+        activeTrackIds: TRACK_IDS,
+        textTrackStyle: { type: 'object', optional: true }
+    }
+};
@@ -0,0 +1,187 @@
+/**
+ * The conditions a request can wait for before it is acknowledged.
+ *
+ * @readonly
+ * @enum {string}
+ */
+export const Completion = {
+    /**
+     * The request has been handled, acknowledge it with the next status.
+     */
+    IMMEDIATE: 'immediate',
+    /**
+     * Wait for the player to finish seeking.
+     */
+    SEEKED: 'seeked',
+    /**
+     * Wait for an item to be loaded.
+     */
+    LOADED: 'loaded',
+    /**
+     * Wait for the player to apply a track change.
+     */
+    TRACKS: 'tracks'
+};
+
+/**
+ * Correlates requests with the status updates that acknowledge them.
+ *
+ * Every request that is being handled is added to the table. Requests
+ * that have to wait for the player are deferred with a completion
+ * condition, all other requests are completed once they have been handled.
+ * Completed requests are taken out of the table by the next status update.
+ *
+ * requestIds are only unique per sender, so requests are identified by
+ * their senderId and requestId, which are returned as {senderId, requestId}.
+ *
+ * Example Usage:
+ *
+ * let requests = new PendingRequests();
+ * requests.add(senderId, requestId);
+ * requests.defer(senderId, requestId, Completion.SEEKED);
+ * requests.settle(senderId, requestId); // No-op, the request waits for SEEKED.
+ * ...
+ * requests.complete(Completion.SEEKED);
+ * requests.takeCompleted(); // [[{senderId, requestId}]]
+ */
+export default class PendingRequests {
+
+    constructor() {
+        // Maps senderId:requestId to the request and its completion condition.
+        this.pending = new Map();
+        // Groups of completed requests.
+        this.completed = [];
+    }
+
+    /**
+     * The number of requests that are waiting for a condition.
+     */
+    get size() {
+        return this.pending.size;
+    }
+
+    /**
+     * Adds a request that is being handled.
+     */
+    add(senderId, requestId) {
+        if (requestId) {
+            this.pending.set(getKey(senderId, requestId), {
+                senderId: senderId,
+                requestId: requestId,
+                condition: Completion.IMMEDIATE
+            });
+        }
+    }
+
+    /**
+     * Makes a request wait for the given condition.
+     */
+    defer(senderId, requestId, condition) {
+        let entry = this.pending.get(getKey(senderId, requestId));
+        if (entry) {
+            entry.condition = condition;
+        }
+    }
+
+    /**
+     * Returns whether any request waits for the given condition.
+     */
+    isWaiting(condition) {
+        let waiting = false;
+        this.pending.forEach(entry => {
+            waiting = waiting || entry.condition === condition;
+        });
+        return waiting;
+    }
+
+    /**
+     * Completes a request that has been handled, unless it has been deferred.
+     */
+    settle(senderId, requestId) {
+        let key = getKey(senderId, requestId);
+        let entry = this.pending.get(key);
+        if (entry && entry.condition === Completion.IMMEDIATE) {
+            this.pending.delete(key);
+            this.completed.push([getRequest(entry)]);
+        }
+    }
+
+    /**
+     * Completes all requests that wait for the given condition.
+     *
+     * @param {Completion} condition The condition that has been met.
+     * @param {boolean} merge Whether the requests should be acknowledged
+     * together, e.g. because they have superseded each other.
+     * @return {boolean} Whether any request has been completed.
+     */
+    complete(condition, merge) {
+        let requests = this.take(condition);
+        if (merge && requests.length) {
+            this.completed.push(requests);
+        } else {
+            requests.forEach(request => this.completed.push([request]));
+        }
+        return requests.length > 0;
+    }
+
+    /**
+     * Removes all requests that wait for the given condition, e.g. because
+     * the condition can no longer be met.
+     *
+     * @return {Array<{senderId: string, requestId: number}>} The requests that have been removed.
+     */
+    take(condition) {
+        let requests = [];
+        this.pending.forEach((entry, key) => {
+            if (entry.condition === condition) {
+                requests.push(getRequest(entry));
+                this.pending.delete(key);
+            }
+        });
+        return requests;
+    }
+
+    /**
+     * Removes a request, e.g. because it resulted in an error.
+     */
+    remove(senderId, requestId) {
+        this.pending.delete(getKey(senderId, requestId));
+    }
+
+    /**
+     * Removes and returns the requests that have been completed, in groups
+     * of requests that are acknowledged by a single status update.
+     *
+     * @return {Array<Array<{senderId: string, requestId: number}>>} The groups of requests.
+     */
+    takeCompleted() {
+        let requests = this.completed;
+        this.completed = [];
+        return requests;
+    }
+
+    /**
+     * Removes all requests that wait for a condition. Requests that have
+     * been completed are kept until they have been acknowledged.
+     *
+     * @return {Array<{senderId: string, requestId: number}>} The requests that have been removed.
+     */
+    clear() {
+        let requests = [];
+        this.pending.forEach(entry => requests.push(getRequest(entry)));
+        this.pending.clear();
+        return requests;
+    }
+
+}
+
+function getKey(senderId, requestId) {
+    return `${senderId}:${requestId}`;
+}
+
+function getRequest(entry) {
+    return {
+        senderId: entry.senderId,
+        requestId: entry.requestId
+    };
+}
@@ -0,0 +1,118 @@
+/**
+ * The number of recent requests that are remembered per sender.
+ */
+export const MAX_REQUESTS_PER_SENDER = 16;
+
+/**
+ * The number of senders for which recent requests are remembered.
+ */
+export const MAX_SENDERS = 8;
+
+/**
+ * Remembers recent requests per sender, together with the reply they got,
+ * so that retried requests can be answered without executing them again.
+ *
+ * Both the requests per sender and the senders are evicted in least
+ * recently used order.
+ *
+ * Example Usage:
+ *
+ * let cache = new RequestCache();
+ * let entry = cache.lookup(senderId, requestId);
+ * if (entry) {
+ *     // A retry, entry.reply is null while the request is in flight.
+ * } else {
+ *     cache.add(senderId, requestId);
+ *     ...
+ *     cache.setReply(senderId, requestId, reply);
+ *     // Or, if the request has been dropped:
+ *     cache.forget(senderId, requestId);
+ * }
+ */
+export default class RequestCache {
+
+    constructor() {
+        // Maps senderIds to a Map of requestIds to entries.
+        this.senders = new Map();
+        this.stats = {
+            hits: 0,
+            misses: 0
+        };
+    }
+
+    /**
+     * Returns the entry of a request that has been seen before, or null.
+     */
+    lookup(senderId, requestId) {
+        let requests = this.senders.get(senderId);
+        let entry = requests ? requests.get(requestId) : undefined;
+        if (!entry) {
+            this.stats.misses++;
+            return null;
+        }
+        this.stats.hits++;
+        return entry;
+    }
+
+    /**
+     * Remembers a request that is being handled.
+     */
+    add(senderId, requestId) {
+        let requests = this.senders.get(senderId);
+        if (requests) {
+            // Mark the sender as most recently used.
+            this.senders.delete(senderId);
+        } else {
+            requests = new Map();
+            if (this.senders.size >= MAX_SENDERS) {
+                this.senders.delete(this.senders.keys().next().value);
+            }
+        }
+        this.senders.set(senderId, requests);
+
+        if (requests.size >= MAX_REQUESTS_PER_SENDER) {
+            requests.delete(requests.keys().next().value);
+        }
+        requests.set(requestId, {
+            reply: null
+        });
+    }
+
+    /**
+     * Stores the reply to a request. Only the first reply to a request is stored.
+     *
+     * @param {string} senderId The sender of the request.
+     * @param {number} requestId The id of the request.
+     * @param {string} reply The JSON of the reply.
+     */
+    setReply(senderId, requestId, reply) {
+        let requests = this.senders.get(senderId);
+        let entry = requestId && requests ? requests.get(requestId) : undefined;
+        if (entry && entry.reply === null) {
+            entry.reply = reply;
+        }
+    }
+
+    /**
+     * Forgets a request that has not been answered, e.g. because it was
+     * dropped or failed, so that a retry executes it again.
+     *
+     * @param {string} senderId The sender of the request.
+     * @param {number} requestId The id of the request.
+     */
+    forget(senderId, requestId) {
+        let requests = this.senders.get(senderId);
+        let entry = requests ? requests.get(requestId) : undefined;
+        if (entry && entry.reply === null) {
+            requests.delete(requestId);
+        }
+    }
+
+    /**
+     * Returns the number of cache hits and misses.
+     */
+    getStats() {
+        return Object.assign({}, this.stats);
+    }
+
+}
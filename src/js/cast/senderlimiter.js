@@ -0,0 +1,104 @@
+/**
+ * The default number of requests per second a sender can make before
+ * it is limited.
+ */
+export const DEFAULT_RATE = 5;
+
+/**
+ * The number of senders that are tracked, senders that have not sent a
+ * request in a while are forgotten first.
+ */
+export const MAX_SENDERS = 8;
+
+/**
+ * Limits the rate of requests per sender using a token bucket, and keeps
+ * counters per sender.
+ *
+ * Every sender starts with a full bucket of 2 * rate tokens, which is
+ * refilled at rate tokens per second. Every request takes a token,
+ * requests that find the bucket empty are limited.
+ *
+ * Example Usage:
+ *
+ * let limiter = new SenderLimiter(5);
+ * if (!limiter.take(senderId)) {
+ *     // The sender is over its limit.
+ * }
+ * limiter.count(senderId, 'collapsed');
+ *
+ * @param {number} rate The number of requests per second, 0 disables the limit.
+ */
+export default class SenderLimiter {
+
+    constructor(rate) {
+        this.rate = typeof (rate) === 'number' && rate >= 0 ? rate : DEFAULT_RATE;
+        this.burst = 2 * this.rate;
+        // Maps senderIds to their bucket and counters.
+        this.senders = new Map();
+    }
+
+    /**
+     * Takes a token from the bucket of a sender.
+     *
+     * @return {boolean} Whether the request is within the limit.
+     */
+    take(senderId) {
+        let sender = this.getSender(senderId);
+        sender.stats.requests++;
+        if (!this.rate) {
+            return true;
+        }
+
+        let now = Date.now();
+        sender.tokens = Math.min(this.burst, sender.tokens + (now - sender.refillTime) * this.rate / 1000);
+        sender.refillTime = now;
+        if (sender.tokens < 1) {
+            sender.stats.limited++;
+            return false;
+        }
+        sender.tokens--;
+        return true;
+    }
+
+    /**
+     * Increases a counter of a sender.
+     */
+    count(senderId, counter) {
+        let stats = this.getSender(senderId).stats;
+        stats[counter] = (stats[counter] || 0) + 1;
+    }
+
+    /**
+     * Returns the counters per senderId.
+     */
+    getStats() {
+        let stats = {};
+        this.senders.forEach((sender, senderId) => {
+            stats[senderId] = Object.assign({}, sender.stats);
+        });
+        return stats;
+    }
+
+    getSender(senderId) {
+        let sender = this.senders.get(senderId);
+        if (sender) {
+            // Mark the sender as most recently used.
+            this.senders.delete(senderId);
+        } else {
+            sender = {
+                tokens: this.burst,
+                refillTime: Date.now(),
+                stats: {
+                    requests: 0,
+                    limited: 0
+                }
+            };
+            if (this.senders.size >= MAX_SENDERS) {
+                this.senders.delete(this.senders.keys().next().value);
+            }
+        }
+        this.senders.set(senderId, sender);
+        return sender;
+    }
+
+}
@@ -0,0 +1,132 @@
+import * as Events from '../events';
+
+/**
+ * The default minimum interval between two position samples, in milliseconds.
+ */
+export const DEFAULT_SAMPLE_INTERVAL = 250;
+
+/**
+ * The interval at which MEDIA_PROGRESS is published, in milliseconds.
+ */
+export const PROGRESS_INTERVAL = 1000;
+
+/**
+ * Distributes the playback position reported by the player.
+ *
+ * The position is sampled at most once per sampleInterval (config.timeUpdateInterval).
+ * Samples are published as:
+ * - MEDIA_TIME: at display cadence (one per animation frame), while the
+ *   display is enabled. For consumers that update the DOM.
+ * - MEDIA_PROGRESS: once a second, and immediately when the position jumps
+ *   backwards or the duration changes. For consumers that run logic.
+ *
+ * A single sample object is reused for all events, consumers should copy
+ * the values they want to keep.
+ */
+export default function TimePipeline(events, config) {
+
+    let sampleInterval = config && typeof (config.timeUpdateInterval) === 'number'
+        && config.timeUpdateInterval >= 0 ? config.timeUpdateInterval : DEFAULT_SAMPLE_INTERVAL;
+
+    // The latest sample.
+    let sample = {
+        currentTime: 0,
+        duration: 0
+    };
+
+    let lastSampleTime = -Infinity;
+    let lastProgressTime = -Infinity;
+
+    // Whether MEDIA_TIME should be published.
+    let displayEnabled = true;
+    let frameId = -1;
+
+    let stats = {
+        updates: 0,
+        samples: 0,
+        frames: 0,
+        progress: 0
+    };
+
+    function publishFrame() {
+        frameId = -1;
+        if (displayEnabled) {
+            stats.frames++;
+            events.publish(Events.MEDIA_TIME, sample);
+        }
+    }
+
+    function requestFrame() {
+        if (frameId == -1 && displayEnabled) {
+            frameId = window.requestAnimationFrame(publishFrame);
+        }
+    }
+
+    function cancelFrame() {
+        if (frameId != -1) {
+            window.cancelAnimationFrame(frameId);
+            frameId = -1;
+        }
+    }
+
+    return {
+        /**
+         * Handles a position update of the player.
+         */
+        update: function(position, duration) {
+            stats.updates++;
+            let now = Date.now();
+            let jumped = position < sample.currentTime || duration != sample.duration;
+            let progressDue = jumped || now - lastProgressTime >= PROGRESS_INTERVAL;
+            if (!progressDue && now - lastSampleTime < sampleInterval) {
+                return;
+            }
+            stats.samples++;
+            lastSampleTime = now;
+            sample.currentTime = position;
+            sample.duration = duration;
+
+            if (progressDue) {
+                lastProgressTime = now;
+                stats.progress++;
+                events.publish(Events.MEDIA_PROGRESS, sample);
+            }
+            requestFrame();
+        },
+
+        /**
+         * Forgets the current sample, e.g. when a new item is loaded.
+         */
+        reset: function() {
+            cancelFrame();
+            sample.currentTime = 0;
+            sample.duration = 0;
+            lastSampleTime = -Infinity;
+            lastProgressTime = -Infinity;
+        },
+
+        /**
+         * Enables or disables MEDIA_TIME, e.g. while nothing displays it.
+         * Enabling publishes the latest sample on the next frame.
+         */
+        setDisplayEnabled: function(enabled) {
+            if (displayEnabled == enabled) {
+                return;
+            }
+            displayEnabled = enabled;
+            if (enabled) {
+                requestFrame();
+            } else {
+                cancelFrame();
+            }
+        },
+
+        /**
+         * Returns the number of player updates, samples taken and
+         * MEDIA_TIME / MEDIA_PROGRESS events published.
+         */
+        getStats: function() {
+            return Object.assign({}, stats);
+        }
+    };
+}
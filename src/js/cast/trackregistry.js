@@ -0,0 +1,95 @@
+/**
+ * The tracks of a media item, indexed by trackId and by trackContentId,
+ * together with the ids of the tracks that are active.
+ *
+ * New tracks are added to media.tracks and numbered from the highest trackId
+ * the sender used. The registry is kept up to date from player events, so
+ * the active tracks never have to be queried from the player.
+ *
+ * Example Usage:
+ *
+ * let registry = new TrackRegistry(media);
+ * registry.add({ type: TrackType.TEXT, trackContentId: 'captions.vtt' });
+ * registry.setActive(TrackType.TEXT, 'captions.vtt'); // true
+ * registry.activeTrackIds; // [1]
+ *
+ * @param {cast.receiver.media.MediaInformation} media The media item.
+ */
+export default class TrackRegistry {
+
+    constructor(media) {
+        this.media = media;
+        this.tracksById = new Map();
+        // Maps type:trackContentId to tracks.
+        this.tracksByContentId = new Map();
+        // Maps track types to the trackId of the active track of that type.
+        this.activeTracks = new Map();
+        this.activeTrackIds = [];
+        this.nextTrackId = 1;
+
+        if (media && media.tracks) {
+            media.tracks.forEach(track => this.index(track));
+        }
+    }
+
+    /**
+     * Adds a track with a new trackId, unless a track of the same type
+     * and trackContentId exists already.
+     *
+     * @return {boolean} Whether the track has been added.
+     */
+    add(track) {
+        if (this.getByContentId(track.type, track.trackContentId)) {
+            return false;
+        }
+        track.trackId = this.nextTrackId;
+        this.media.tracks = this.media.tracks || [];
+        this.media.tracks.push(track);
+        this.index(track);
+        return true;
+    }
+
+    /**
+     * Returns the track with the given trackId, or null.
+     */
+    getById(trackId) {
+        return this.tracksById.get(trackId) || null;
+    }
+
+    /**
+     * Returns the track of the given type with the given trackContentId, or null.
+     */
+    getByContentId(type, trackContentId) {
+        return this.tracksByContentId.get(`${type}:${trackContentId}`) || null;
+    }
+
+    /**
+     * Makes a track the active track of its type.
+     *
+     * @param {TrackType} type The type of the track.
+     * @param {*} trackContentId The trackContentId of the track, or null
+     * if no track of this type is active.
+     * @return {boolean} Whether the active tracks have changed.
+     */
+    setActive(type, trackContentId) {
+        let track = trackContentId !== null ? this.getByContentId(type, trackContentId) : null;
+        let trackId = track ? track.trackId : null;
+        if ((this.activeTracks.get(type) || null) === trackId) {
+            return false;
+        }
+        if (trackId === null) {
+            this.activeTracks.delete(type);
+        } else {
+            this.activeTracks.set(type, trackId);
+        }
+        this.activeTrackIds = Array.from(this.activeTracks.values());
+        return true;
+    }
+
+    index(track) {
+        this.tracksById.set(track.trackId, track);
+        this.tracksByContentId.set(`${track.type}:${track.trackContentId}`, track);
+        this.nextTrackId = Math.max(this.nextTrackId, track.trackId + 1);
+    }
+
+}
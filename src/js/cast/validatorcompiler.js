@@ -0,0 +1,155 @@
+import { MessageSchema } from './messages';
+
+/**
+ * Conditions that hold when a value has a given type.
+ */
+const TYPE_CHECKS = {
+    string: value => `typeof ${value} === 'string'`,
+    number: value => `Number.isFinite(${value})`,
+    integer: value => `Number.isInteger(${value})`,
+    boolean: value => `typeof ${value} === 'boolean'`,
+    object: value => `${value} !== null && typeof ${value} === 'object' && !Array.isArray(${value})`,
+    array: value => `Array.isArray(${value})`
+};
+
+/**
+ * Normalizers, these emit code that runs once a value has been validated.
+ */
+const NORMALIZERS = {
+    /**
+     * Parses an ad schedule offset ('pre', 'post', 'hh:mm:ss', 'NN%' or seconds)
+     * into {position: seconds} or {fraction: fraction of the duration}.
+     */
+    offset: (value, parent, path, context, indent) => {
+        let offset = context.variable();
+        let parsed = context.variable();
+        context.lines.push(
+            `${indent}var ${offset} = String(${value});`,
+            `${indent}var ${parsed} = ${offset} === 'pre' ? { position: 0 }`,
+            `${indent}    : ${offset} === 'post' ? { fraction: 1 }`,
+            `${indent}    : ${offset}.slice(-1) === '%' ? { fraction: Number.parseFloat(${offset}.slice(0, -1)) / 100 }`,
+            `${indent}    : { position: ${offset}.indexOf(':') !== -1 ? jwplayer.utils.seconds(${offset}) : Number.parseFloat(${offset}) };`,
+            `${indent}if (!(${parsed}.position >= 0) && !(${parsed}.fraction >= 0)) {`,
+            `${indent}    return ${JSON.stringify(path)};`,
+            `${indent}}`,
+            `${indent}Object.defineProperty(${parent}, 'parsedOffset', { value: ${parsed}, configurable: true });`
+        );
+    }
+};
+
+function compileFields(fields, object, path, context, indent) {
+    Object.keys(fields).forEach(name => {
+        compileField(fields[name], object, name, path ? `${path}.${name}` : name, context, indent);
+    });
+}
+
+function compileField(spec, object, name, path, context, indent) {
+    let value = context.variable();
+    let property = `${object}[${JSON.stringify(name)}]`;
+    context.lines.push(`${indent}var ${value} = ${property};`);
+    if (spec.optional) {
+        context.lines.push(
+            `${indent}if (${value} === null) {`,
+            `${indent}    delete ${property};`,
+            `${indent}} else if (${value} !== undefined) {`
+        );
+        compileValue(spec, value, object, path, context, `${indent}    `);
+        context.lines.push(`${indent}}`);
+    } else {
+        compileValue(spec, value, object, path, context, indent);
+    }
+}
+
+function compileValue(spec, value, parent, path, context, indent) {
+    let types = [].concat(spec.type);
+    let valid = types.map(type => TYPE_CHECKS[type](value));
+    let checks = [`!(${valid.length > 1 ? `(${valid.join(') || (')})` : valid[0]})`];
+    if (spec.min !== undefined) {
+        checks.push(`${value} < ${spec.min}`);
+    }
+    if (spec.minItems !== undefined) {
+        checks.push(`${value}.length < ${spec.minItems}`);
+    }
+    if (spec.values) {
+        let values = Object.keys(spec.values).map(key => `${value} !== ${JSON.stringify(spec.values[key])}`);
+        checks.push(`(${values.join(' && ')})`);
+    }
+    context.lines.push(
+        `${indent}if (${checks.join(' || ')}) {`,
+        `${indent}    return ${JSON.stringify(path)};`,
+        `${indent}}`
+    );
+
+    if (spec.fields) {
+        compileFields(spec.fields, value, path, context, indent);
+    }
+    if (spec.items) {
+        let index = context.variable();
+        let item = context.variable();
+        context.lines.push(
+            `${indent}for (var ${index} = 0; ${index} < ${value}.length; ${index}++) {`,
+            `${indent}    var ${item} = ${value}[${index}];`
+        );
+        compileValue(spec.items, item, value, `${path}[]`, context, `${indent}    `);
+        context.lines.push(`${indent}}`);
+    }
+    if (spec.entries) {
+        let key = context.variable();
+        let entry = context.variable();
+        context.lines.push(
+            `${indent}for (var ${key} in ${value}) {`,
+            `${indent}    if (!Object.prototype.hasOwnProperty.call(${value}, ${key})) {`,
+            `${indent}        continue;`,
+            `${indent}    }`,
+            `${indent}    var ${entry} = ${value}[${key}];`
+        );
+        compileValue(spec.entries, entry, value, `${path}{}`, context, `${indent}    `);
+        context.lines.push(`${indent}}`);
+    }
+    if (spec.normalize) {
+        NORMALIZERS[spec.normalize](value, parent, path, context, indent);
+    }
+}
+
+/**
+ * Compiles a message schema into straight-line validator functions.
+ *
+ * The generated code is a function body that returns a map of EventTypes to
+ * validators. A validator takes the data of a request, normalizes it in place
+ * and returns null, or returns the path of the first field that is invalid.
+ * The gulpfile compiles the schema at build time and bundles the result
+ * in place of validators.js.
+ *
+ * @param {Object} schema The schemas keyed by EventType, see MessageSchema.
+ * @return {string} The source of the function body.
+ */
+export function compileValidators(schema = MessageSchema) {
+    let source = ['var validators = {};'];
+    Object.keys(schema).forEach(type => {
+        let variables = 0;
+        let context = {
+            lines: [],
+            variable: () => `v${variables++}`
+        };
+        compileFields(schema[type], 'data', '', context, '    ');
+        source.push(
+            `validators[${JSON.stringify(type)}] = function(data) {`,
+            ...context.lines,
+            '    return null;',
+            '};'
+        );
+    });
+    source.push('return validators;');
+    return source.join('\n');
+}
+
+/**
+ * Compiles a message schema into validators at runtime, for when the
+ * sources are used without the build.
+ *
+ * @param {Object} schema The schemas keyed by EventType, see MessageSchema.
+ * @return {Object<string, function(Object): ?string>} The validators keyed by EventType.
+ */
+export function createValidators(schema = MessageSchema) {
+    return new Function(compileValidators(schema))(); // eslint-disable-line no-new-func
+}
@@ -0,0 +1,10 @@
+import { createValidators } from './validatorcompiler';
+
+/**
+ * Validators for the requests in MessageSchema, keyed by EventType.
+ *
+ * The build replaces this module with validators that have been compiled
+ * from the schema ahead of time (see gulpfile.js), so the compiler does not
+ * end up in the bundle.
+ */
+export default createValidators();
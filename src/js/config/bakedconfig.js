@@ -0,0 +1,7 @@
+/**
+ * The config that has been built into the app with the build:app task
+ * (see gulpfile.js), or null.
+ *
+ * {appName: string, config: Object, time: number}
+ */
+export default null;
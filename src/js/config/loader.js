@@ -1,30 +1,132 @@
 import Http from '../utils/http';
 
+/**
+ * The prefix of the localStorage keys configs are cached under, followed by the appName.
+ */
+export const CACHE_KEY_PREFIX = 'jwcast-config:';
+
 export default class ConfigLoader {
 
-    static getConfig(appName) {
+    /**
+     * Resolves the config of an app.
+     *
+     * A cached config is used right away, and revalidated in the background
+     * so that the next launch uses the latest version. Without a cached config
+     * the local and the remote config are requested at the same time, the
+     * first valid one is used and cached.
+     *
+     * @param {string} appName The name of the app.
+     * @param {Object=} baked The config that has been built into the app,
+     * which is used unless a newer config has been cached.
+     */
+    static getConfig(appName, baked) {
+        let cached = ConfigLoader.readCache(appName);
+        if (baked && !(cached && cached.time > baked.time)) {
+            // Refresh it for the next launch.
+            ConfigLoader.raceConfigs(appName).catch((error) => {
+                console.warn('Unable to refresh the configuration: %O', error);
+            });
+            return Promise.resolve(baked.config);
+        }
+        if (cached && cached.config && ConfigLoader.validateConfig(cached.config)) {
+            ConfigLoader.revalidate(appName, cached);
+            return Promise.resolve(cached.config);
+        }
+        return ConfigLoader.raceConfigs(appName);
+    }
+
+    static raceConfigs(appName) {
         const localConfig = `./${appName}/config.json`;
         const remoteConfig = `https://${appName}.jwpapp.com/config.json`;
 
         return new Promise((resolve, reject) => {
-            ConfigLoader.requestConfig(localConfig, resolve, function() {
-                ConfigLoader.requestConfig(remoteConfig, resolve, reject);
+            let failures = 0;
+            let resolved = false;
+            [localConfig, remoteConfig].forEach(configUrl => {
+                ConfigLoader.requestConfig(configUrl).then(entry => {
+                    if (!resolved) {
+                        resolved = true;
+                        ConfigLoader.writeCache(appName, entry);
+                        resolve(entry.config);
+                    }
+                }, error => {
+                    if (++failures == 2) {
+                        reject(error);
+                    }
+                });
             });
         });
     }
 
-    static requestConfig(configUrl, resolve, reject) {
-        Http.get(configUrl).then((config) => {
-            if (this.validateConfig(config)) {
-                resolve(config);
-            } else {
-                reject('Invalid configuration: ' + configUrl);
+    /**
+     * Requests a config, conditionally if a cache entry is given.
+     *
+     * @return {Promise} Resolves with a cache entry, or with null if
+     * the cache entry is still up to date.
+     */
+    static requestConfig(configUrl, cached) {
+        let headers = {};
+        if (cached && cached.etag) {
+            headers['If-None-Match'] = cached.etag;
+        }
+        if (cached && cached.lastModified) {
+            headers['If-Modified-Since'] = cached.lastModified;
+        }
+        return Http.request('GET', configUrl, headers, {
+            responseType: 'json'
+        }).then((client) => {
+            if (client.status == 304) {
+                return null;
+            }
+            let config = client.response;
+            if (!config || !this.validateConfig(config)) {
+                return Promise.reject('Invalid configuration: ' + configUrl);
             }
-        }).catch(function() {
-            reject('Invalid configuration: ' + configUrl);
+            return {
+                url: configUrl,
+                config: config,
+                time: Date.now(),
+                etag: client.getResponseHeader('ETag'),
+                lastModified: client.getResponseHeader('Last-Modified')
+            };
+        }, () => {
+            return Promise.reject('Invalid configuration: ' + configUrl);
         });
     }
 
+    /**
+     * Updates a cached config in the background. If the config can no longer
+     * be requested from where it was found, both candidates are tried again.
+     */
+    static revalidate(appName, cached) {
+        ConfigLoader.requestConfig(cached.url, cached)
+            .then((entry) => {
+                if (entry) {
+                    ConfigLoader.writeCache(appName, entry);
+                }
+            }, () => ConfigLoader.raceConfigs(appName))
+            .catch((error) => {
+                console.warn('Unable to revalidate the configuration: %O', error);
+            });
+    }
+
+    static readCache(appName) {
+        try {
+            let entry = window.localStorage.getItem(CACHE_KEY_PREFIX + appName);
+            return entry ? JSON.parse(entry) : null;
+        } catch (err) {
+            return null;
+        }
+    }
+
+    static writeCache(appName, entry) {
+        try {
+            window.localStorage.setItem(CACHE_KEY_PREFIX + appName, JSON.stringify(entry));
+        } catch (err) {
+            console.warn('Unable to cache the configuration: %O', err);
+        }
+    }
+
     static validateConfig(config) {
         let valid = true;
         // At minimum we need a player key.
@@ -38,10 +38,17 @@ export const MEDIA_SEEK = 'mediaSeek';
 export const MEDIA_SEEKED = 'mediaSeeked';
 
 /**
- * Fired when content playback progresses.
+ * Fired when content playback progresses, at most once per display frame.
+ * Not fired while the progress is not being displayed.
  */
 export const MEDIA_TIME = 'mediaTime';
 
+/**
+ * Fired once per second while content playback progresses, and when
+ * the position jumps backwards.
+ */
+export const MEDIA_PROGRESS = 'mediaProgress';
+
 /**
  * Fired when a media item has completed playback.
  */
@@ -1,29 +1,32 @@
 import JWMediaManager from './cast/mediamanager';
 import UIController from './uicontroller';
-import RelatedController from './related/controller';
 import EventBus, * as Events from './events';
 import AnalyticsConfig from './analytics/config';
 import TimeOutHandler from './utils/timeouthandler';
+import ChunkLoader from './utils/chunkloader';
 
 export const APP_VERSION = '1.0.0';
 
 /* eslint no-unused-vars: 0*/
 
-export default function JWCastApp(element, config) {
+/**
+ * The receiver app.
+ *
+ * @param {HTMLElement} element The app container.
+ * @param {Object} config The app config.
+ * @param {cast.receiver.CastReceiverManager} receiverManager The receiver manager,
+ * which has been started already.
+ * @param {MessageBuffer} messageBuffer The media messages that arrived while
+ * the app was starting.
+ * @param {Promise} receiverReady Resolves with the ready event of the receiver manager.
+ */
+export default function JWCastApp(element, config, receiverManager, messageBuffer, receiverReady) {
     // Create an event bus.
     let events = new EventBus();
 
     let timeoutHandler;
 
-    // Create a receiver manager and apply overrides.
-    let receiverManager = cast.receiver.CastReceiverManager.getInstance();
-    receiverManager.onReady = (event) => {
-        events.publish(Events.APP_READY, event);
-
-        // Create a timeout handler.
-        timeoutHandler = new TimeOutHandler(events, receiverManager);
-    };
-
+    // Apply overrides to the receiver manager.
     receiverManager.onSenderDisconnected = function(event) {
         // When the last or only sender is connected to a receiver,
         // tapping Disconnect stops the app running on the receiver.
@@ -35,16 +38,29 @@ export default function JWCastApp(element, config) {
 
     // Create a media manager.
     let mediaManager = new JWMediaManager(receiverManager, document.getElementById('player'),
-        events, new AnalyticsConfig(config));
+        events, new AnalyticsConfig(config), config, messageBuffer);
 
     // Create some UI.
     let uiController = new UIController(element, events, config, mediaManager);
 
-    // Create a related controller.
+    // Create a related controller. Its chunk has been requested while the
+    // config was loading, media messages wait for it so it sees every item.
+    let relatedReady = Promise.resolve();
     if (typeof (config.recommendationsPlaylist) === 'string') {
-        let relatedController = new RelatedController(config, events, mediaManager);
+        relatedReady = ChunkLoader.load('related').then((related) => {
+            let relatedController = new related.RelatedController(config, events, mediaManager);
+        }, (error) => {
+            console.error('Recommendations are unavailable: %O', error);
+        });
     }
 
-    // Start the application!
-    receiverManager.start();
+    // Start the application! The receiver might have become ready while
+    // the config was loading.
+    receiverReady.then((event) => {
+        events.publish(Events.APP_READY, event);
+
+        // Create a timeout handler.
+        timeoutHandler = new TimeOutHandler(events, receiverManager);
+    });
+    relatedReady.then(() => messageBuffer.release());
 }
@@ -1,15 +1,19 @@
 import JWCastApp from './jwcastapp.js';
 import ConfigLoader from './config/loader';
+import bakedConfig from './config/bakedconfig';
+import MessageBuffer from './cast/messagebuffer';
+import ChunkLoader from './utils/chunkloader';
+import { getAssetUrl } from './utils/assets';
 
 /* eslint no-console: 0*/
 
-// Global debug setting.
-window.DEBUG = jwplayer.version.search(/[0-9]+\.[0-9]+\.[0-9].*\+local\./) != -1;
+// The cast SDK and jwplayer.js are loaded in parallel with this script by the
+// loader in index.html, so nothing here may use them before whenLoaded().
 
-// Enable debug logging for local jwplayer.js versions.
-if (DEBUG) {
-    cast.receiver.logger.setLevelValue(cast.receiver.LoggerLevel.DEBUG);
-}
+// The receiver, started as soon as the cast SDK has been loaded.
+let receiverManager;
+let messageBuffer;
+let receiverReady;
 
 // The instance of the receiver app.
 let app;
@@ -17,36 +21,69 @@ let app;
 // The configuration the receiver app has been instantiated with.
 let loadedConfig;
 
-// Retrieve the config by API key.
-let appName = getParam('appName');
+// Retrieve the config by API key, while the SDKs are still loading.
+let appName = getParam('appName') || (bakedConfig && bakedConfig.appName);
 let jwKey = getParam('key');
+let configLoaded;
 
 if (appName) {
-    ConfigLoader.getConfig(appName)
-        .then((config) => {
-            // Set the player key.
-            jwplayer.key = config.key || jwKey;
-            loadedConfig = config;
-            // Check whether we can init the application.
-            maybeInit();
-        }, error => {
-            console.error(error);
-            exitApp();
-        });
+    let baked = bakedConfig && bakedConfig.appName == appName ? bakedConfig : null;
+    configLoaded = ConfigLoader.getConfig(appName, baked);
 } else if (jwKey) {
-    jwplayer.key = jwKey;
-    loadedConfig = {
+    configLoaded = Promise.resolve({
         siteName: 'Chromecast Player',
         theme: 'dark',
         logoUrl: '',
         key: jwKey
-    };
-    maybeInit();
+    });
 } else {
-    console.error('Error: appName missing.');
-    exitApp();
+    configLoaded = Promise.reject('Error: appName missing.');
 }
 
+configLoaded.then((config) => {
+    // Only the stylesheet of the selected theme is loaded.
+    loadTheme(config.theme);
+    // Request the recommendations chunk early, JWCastApp waits for it.
+    if (typeof (config.recommendationsPlaylist) === 'string') {
+        ChunkLoader.load('related').catch(() => {});
+    }
+}, () => {});
+
+// Start the receiver right away, so that senders can connect while the config
+// is loading. Media messages are buffered until the app can handle them.
+let castLoaded = whenLoaded('cast').then(() => {
+    receiverManager = cast.receiver.CastReceiverManager.getInstance();
+    messageBuffer = new MessageBuffer(
+        receiverManager.getCastMessageBus(cast.receiver.media.MEDIA_NAMESPACE));
+    receiverReady = new Promise(resolve => {
+        receiverManager.onReady = resolve;
+    });
+    receiverReady.then(() => console.info('Receiver ready after %dms', Math.round(performance.now())));
+    receiverManager.start();
+});
+
+Promise.all([castLoaded, whenLoaded('jwplayer')])
+    .then(() => {
+        // Global debug setting.
+        window.DEBUG = jwplayer.version.search(/[0-9]+\.[0-9]+\.[0-9].*\+local\./) != -1;
+
+        // Enable debug logging for local jwplayer.js versions.
+        if (DEBUG) {
+            cast.receiver.logger.setLevelValue(cast.receiver.LoggerLevel.DEBUG);
+        }
+        return configLoaded;
+    })
+    .then((config) => {
+        // Set the player key.
+        jwplayer.key = config.key || jwKey;
+        loadedConfig = config;
+        // Check whether we can init the application.
+        maybeInit();
+    }, error => {
+        console.error(error);
+        castLoaded.then(exitApp);
+    });
+
 // Init the application in case the config has been loaded already.
 document.addEventListener('DOMContentLoaded', maybeInit);
 
@@ -57,8 +94,41 @@ function maybeInit() {
     if (!app && loadedConfig && document.readyState != 'loading') {
         console.info('Initializing the JWCastApp with config %O', loadedConfig);
         // We're good to go! The document is ready and the config has been loaded.
-        app = new JWCastApp(document.getElementById('app'), loadedConfig);
+        let bufferedMessages = messageBuffer.size;
+        app = new JWCastApp(document.getElementById('app'), loadedConfig,
+            receiverManager, messageBuffer, receiverReady);
+        console.info('App ready after %dms, %d messages were buffered',
+            Math.round(performance.now()), bufferedMessages);
+    }
+}
+
+/**
+ * Resolves once a script has been loaded by the loader in index.html.
+ * Resolves right away when the page loads its scripts without the loader.
+ *
+ * @param {string} name The name the script has been registered under.
+ */
+function whenLoaded(name) {
+    return new Promise(resolve => {
+        if (window.JWCastLoader) {
+            window.JWCastLoader.require(name, resolve);
+        } else {
+            resolve();
+        }
+    });
+}
+
+/**
+ * Adds the stylesheet of a theme to the document.
+ */
+function loadTheme(theme) {
+    if (typeof (theme) !== 'string' || !/^[\w-]+$/.test(theme)) {
+        return;
     }
+    let link = document.createElement('link');
+    link.rel = 'stylesheet';
+    link.href = getAssetUrl(`css/theme/theme-${theme}.css`);
+    document.head.appendChild(link);
 }
 
 /**
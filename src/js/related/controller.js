@@ -20,7 +20,7 @@ export default function RelatedController(config, events, mediaManager) {
     }
 
     if (offset) {
-        events.subscribe(Events.MEDIA_TIME, handleTime);
+        events.subscribe(Events.MEDIA_PROGRESS, handleTime);
         events.subscribe(Events.MEDIA_LOADED, event => {
             feedRequested = false;
             let media = event.media;
@@ -0,0 +1,7 @@
+import RelatedController from './controller';
+
+/**
+ * The recommendations chunk. The build splits it off app.js (see gulpfile.js),
+ * it is only loaded for apps that have a recommendationsPlaylist.
+ */
+export { RelatedController };
@@ -110,12 +110,14 @@ export default function UIController(element, events, config, mediaManager) {
     function setState(state) {
         uiState = state;
         element.className = `${state} ${activeFlags.join(' ')}`;
+        updateTimeDisplay();
     }
 
     function setFlag(flag) {
         if (activeFlags.indexOf(flag) < 0) {
             utils.addClass(element, flag);
             activeFlags.push(flag);
+            updateTimeDisplay();
         }
     }
 
@@ -124,9 +126,21 @@ export default function UIController(element, events, config, mediaManager) {
         if (flagIndex >= 0) {
             utils.removeClass(element, flag);
             activeFlags.splice(flagIndex, 1);
+            updateTimeDisplay();
         }
     }
 
+    /**
+     * Time updates are only needed while the overlay is visible, it is hidden
+     * during playback when the user is inactive (unless seeking).
+     */
+    function updateTimeDisplay() {
+        let overlayHidden = activeFlags.indexOf(Flag.USER_INACTIVE) >= 0
+            && activeFlags.indexOf(Flag.SEEK) < 0
+            && (uiState == UIState.CONTENT_STATE_PLAYING || uiState == UIState.CONTENT_STATE_PAUSED);
+        mediaManager.setTimeDisplayEnabled(!overlayHidden);
+    }
+
     function userActivityHandler() {
         clearTimeout(userActivityTimeoutId);
         removeFlag(Flag.USER_INACTIVE);
@@ -187,7 +201,14 @@ export default function UIController(element, events, config, mediaManager) {
    * Event Handlers
    */
 
-    events.subscribe(Events.APP_READY, () => setState(UIState.APP_STATE_IDLE));
+    events.subscribe(Events.APP_READY, () => {
+        setState(UIState.APP_STATE_IDLE);
+        // Track the time to the first paint of the idle screen; the second
+        // frame callback runs once the idle state has been painted.
+        window.requestAnimationFrame(() => window.requestAnimationFrame(() => {
+            console.info('Idle screen painted after %dms', Math.round(performance.now())); // eslint-disable-line no-console
+        }));
+    });
 
     events.subscribe(Events.MEDIA_LOAD, (event) => {
         // Cancel any UI transitions if scheduled.
@@ -212,6 +233,10 @@ export default function UIController(element, events, config, mediaManager) {
     });
 
     events.subscribe(Events.MEDIA_TIME, event => {
+        mediaOverlay.updateContentProgress(event.currentTime, event.duration);
+    });
+
+    events.subscribe(Events.MEDIA_PROGRESS, event => {
         if (event.currentTime < currentTime) {
         // Handle time updates that are smaller than
         // what we we know always as user activity.
@@ -223,7 +248,6 @@ export default function UIController(element, events, config, mediaManager) {
             }
         }
         currentTime = event.currentTime;
-        mediaOverlay.updateContentProgress(event.currentTime, event.duration);
 
         let shouldDisplayNextUp = checkToggleNextUp(currentTime, event.duration);
 
@@ -0,0 +1,13 @@
+/**
+ * Returns the path of a file of the build, relative to index.html.
+ *
+ * Release builds rename files to content-hashed names, index.html maps the
+ * original names of the files that are loaded at runtime (chunks and themes)
+ * to them in window.JWCastAssets.
+ *
+ * @param {string} name The original name of the file, e.g. 'chunks/ads.js'.
+ */
+export function getAssetUrl(name) {
+    let assets = window.JWCastAssets;
+    return assets && assets[name] || name;
+}
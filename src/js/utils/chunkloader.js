@@ -0,0 +1,54 @@
+import { getAssetUrl } from './assets';
+
+/*
+ * Loads the chunks the build splits off app.js (see gulpfile.js), the first
+ * time they are needed. A chunk is a script that adds its exports to
+ * window.JWCastChunks once it has been loaded.
+ *
+ * Example Usage:
+ *
+ * ChunkLoader.load('ads')
+ *  .then(ads => new ads.AdTimeline(schedule));
+ */
+
+/**
+ * The directory the chunks are loaded from, relative to index.html.
+ */
+export const CHUNK_PATH = 'chunks/';
+
+// The chunks that have been requested, keyed by name.
+let requests = {};
+
+export default class ChunkLoader {
+
+    /**
+     * Loads a chunk once, every call resolves with its exports.
+     *
+     * @param {string} name The name of the chunk.
+     */
+    static load(name) {
+        if (!requests[name]) {
+            requests[name] = new Promise((resolve, reject) => {
+                let script = document.createElement('script');
+                script.src = getAssetUrl(`${CHUNK_PATH}${name}.js`);
+                script.async = true;
+                script.onload = () => {
+                    let chunk = window.JWCastChunks && window.JWCastChunks[name];
+                    if (chunk) {
+                        resolve(chunk);
+                    } else {
+                        reject(new Error('Invalid chunk: ' + name));
+                    }
+                };
+                script.onerror = () => {
+                    // Allow the next call to try again.
+                    delete requests[name];
+                    reject(new Error('Unable to load chunk: ' + name));
+                };
+                document.head.appendChild(script);
+            });
+        }
+        return requests[name];
+    }
+
+}
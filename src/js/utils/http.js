@@ -6,12 +6,28 @@
  * http.get(url, [headers], [options])
  *  .then(callback.success)
  *  .catch(callback.error);
+ *
+ * http.request('GET', url, {'If-None-Match': etag})
+ *  .then(client => client.status == 304 ? notModified() : update(client.response));
  */
 
 export const REQUEST_TIMEOUT = 5000;
 
 export default class Http {
     static ajax(method, url, headers, options) {
+        return this.request(method, url, headers, options).then(client => {
+            if (client.status == 304) {
+                return Promise.reject(client.statusText);
+            }
+            return client.response;
+        });
+    }
+
+    /**
+     * Makes a request and resolves with the XMLHttpRequest, so that the
+     * response headers can be read. 304 Not Modified responses resolve as well.
+     */
+    static request(method, url, headers, options) {
         return new Promise((resolve, reject) => {
             var client = new XMLHttpRequest();
             if (options) {
@@ -22,8 +38,8 @@ export default class Http {
                 }
             }
             client.onload = function() {
-                if (this.status >= 200 && this.status < 300) {
-                    resolve(this.response);
+                if (this.status >= 200 && this.status < 300 || this.status == 304) {
+                    resolve(this);
                 } else {
                     reject(this.statusText);
                 }
@@ -31,6 +47,9 @@ export default class Http {
             client.onerror = function() {
                 reject(this.statusText);
             };
+            client.ontimeout = function() {
+                reject('Request timed out: ' + url);
+            };
             client.open(method, url, true);
             if (headers) {
                 for (let header in headers) {
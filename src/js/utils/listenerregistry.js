@@ -0,0 +1,86 @@
+/**
+ * Keeps track of the listeners that have been added to an event emitter
+ * (e.g. a JW Player instance), so that they can be removed as a unit.
+ *
+ * Example Usage:
+ *
+ * let listeners = new ListenerRegistry(playerInstance);
+ * listeners.on('time', handleTime);
+ * listeners.once('ready', handleReady);
+ * ...
+ * listeners.removeAll();
+ */
+export default class ListenerRegistry {
+
+    constructor(target) {
+        this.target = target;
+        this.listeners = [];
+    }
+
+    /**
+     * The number of listeners that are currently registered.
+     */
+    get size() {
+        return this.listeners.length;
+    }
+
+    /**
+     * Adds a listener for one or more space separated events.
+     */
+    on(name, callback) {
+        this.target.on(name, callback);
+        this.listeners.push({
+            name: name,
+            callback: callback
+        });
+        return this;
+    }
+
+    /**
+     * Adds a listener that is removed after it has been invoked once.
+     */
+    once(name, callback) {
+        let listener = {
+            name: name
+        };
+        listener.callback = (event) => {
+            this.forget(listener);
+            callback(event);
+        };
+        this.target.once(name, listener.callback);
+        this.listeners.push(listener);
+        return this;
+    }
+
+    /**
+     * Removes a listener that has been added with on().
+     */
+    off(name, callback) {
+        this.listeners.some(listener => {
+            if (listener.name === name && listener.callback === callback) {
+                this.target.off(name, callback);
+                this.forget(listener);
+                return true;
+            }
+        });
+        return this;
+    }
+
+    /**
+     * Removes all listeners.
+     */
+    removeAll() {
+        this.listeners.forEach(listener => {
+            this.target.off(listener.name, listener.callback);
+        });
+        this.listeners = [];
+    }
+
+    forget(listener) {
+        let index = this.listeners.indexOf(listener);
+        if (index >= 0) {
+            this.listeners.splice(index, 1);
+        }
+    }
+
+}
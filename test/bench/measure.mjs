@@ -0,0 +1,23 @@
+// Runs fn once and prints the elapsed wall time.
+export function measure(name, fn) {
+    const start = process.hrtime.bigint();
+    fn();
+    const ms = Number(process.hrtime.bigint() - start) / 1e6;
+    console.log(`  ${name.padEnd(32)} ${ms.toFixed(1).padStart(8)}ms`);
+}
+
+// Runs fn `iterations` times in each of ROUNDS rounds, and prints the mean
+// time per call of the fastest round, the earlier ones warm up the JIT.
+export const ROUNDS = 5;
+
+export function perCall(name, iterations, fn) {
+    let best = Infinity;
+    for (let round = 0; round < ROUNDS; round++) {
+        const start = process.hrtime.bigint();
+        for (let i = 0; i < iterations; i++) {
+            fn(i);
+        }
+        best = Math.min(best, Number(process.hrtime.bigint() - start) / iterations / 1e3);
+    }
+    console.log(`  ${name.padEnd(32)} ${best.toFixed(1).padStart(8)}us`);
+}
@@ -0,0 +1,71 @@
+// MediaQueue against the array-backed queue it replaced, which scanned
+// for the next item id and for every lookup by id.
+import MediaQueue from '../../src/js/cast/mediaqueue.js';
+import { measure } from './measure.mjs';
+
+const SIZE = 10000;
+const OPS = 1000;
+
+let queue;
+measure('MediaQueue load 10k', () => {
+    queue = new MediaQueue(Array.from({ length: SIZE }, () => ({})));
+});
+measure('MediaQueue insert x1000', () => {
+    for (let i = 0; i < OPS; i++) {
+        queue.insert([{}], SIZE / 2);
+    }
+});
+measure('MediaQueue indexOf x10k', () => {
+    for (let id = 1; id <= SIZE; id++) {
+        queue.indexOf(id);
+    }
+});
+measure('MediaQueue reorder x1000', () => {
+    for (let i = 1; i <= OPS; i++) {
+        queue.reorder([i * 3], i * 7 % SIZE + 1);
+    }
+});
+measure('MediaQueue remove x1000', () => {
+    for (let i = 1; i <= OPS; i++) {
+        queue.remove([i * 5]);
+    }
+});
+
+let items = Array.from({ length: SIZE }, (_, i) => ({ itemId: i + 1 }));
+const find = itemId => {
+    for (let i = 0; i < items.length; i++) {
+        if (items[i].itemId == itemId) {
+            return i;
+        }
+    }
+    return -1;
+};
+const nextItemId = () => items.reduce((max, item) => Math.max(max, item.itemId), 0) + 1;
+
+measure('array insert x1000', () => {
+    for (let i = 0; i < OPS; i++) {
+        items.splice(find(SIZE / 2), 0, { itemId: nextItemId() });
+    }
+});
+measure('array indexOf x10k', () => {
+    for (let id = 1; id <= SIZE; id++) {
+        find(id);
+    }
+});
+measure('array reorder x1000', () => {
+    for (let i = 1; i <= OPS; i++) {
+        let from = find(i * 3);
+        if (from >= 0) {
+            let moved = items.splice(from, 1);
+            items.splice(find(i * 7 % SIZE + 1), 0, ...moved);
+        }
+    }
+});
+measure('array remove x1000', () => {
+    for (let i = 1; i <= OPS; i++) {
+        let index = find(i * 5);
+        if (index >= 0) {
+            items.splice(index, 1);
+        }
+    }
+});
@@ -0,0 +1,15 @@
+// Runs every *.bench.mjs in this directory, or only those whose name
+// contains one of the command line arguments.
+import fs from 'node:fs';
+
+const dir = new URL('./', import.meta.url);
+const filters = process.argv.slice(2);
+const benches = fs.readdirSync(dir)
+    .filter(name => name.endsWith('.bench.mjs'))
+    .filter(name => !filters.length || filters.some(filter => name.indexOf(filter) >= 0))
+    .sort();
+
+for (const name of benches) {
+    console.log(name);
+    await import(new URL(name, dir));
+}
@@ -0,0 +1,69 @@
+// GET_STATUS replies, which join the cached JSON of the queue and the media
+// into the freshly serialized small fields, against serializing the whole
+// status message at once as the receiver used to. The replies without the
+// queue and the media show what the request costs apart from serialization.
+// The queue size limit of MEDIA_STATUS is lifted, so that every reply
+// includes the whole queue. The stub message bus keeps replies as they are,
+// the cast message bus copies each one once when it sends it.
+import { mock } from 'node:test';
+import { players, createReceiverManager, createContainer, createItems, tick } from '../support/receiver.mjs';
+import { perCall, ROUNDS } from './measure.mjs';
+
+const { default: EventBus } = await import('../../src/js/events.js');
+const { GetStatusOptions } = await import('../../src/js/cast/messages.js');
+const { default: JWMediaManager } = await import('../../src/js/cast/mediamanager.js');
+
+async function loadQueue(size) {
+    let receiverManager = createReceiverManager();
+    let log = console.log;
+    console.log = () => {};
+    new JWMediaManager(receiverManager, createContainer(), new EventBus(), {}, {
+        maxStatusQueueSize: Infinity
+    });
+    receiverManager.deliver('sender', { type: 'QUEUE_LOAD', requestId: 1, items: createItems(size) });
+    await tick();
+    players[players.length - 1].trigger('meta', { duration: 600 });
+    await tick();
+    await tick();
+    console.log = log;
+    return receiverManager;
+}
+
+// With mocked timers the scheduled requests run synchronously, and every
+// request falls outside the window in which replies are shared.
+function requestStatus(name, receiverManager, iterations, options) {
+    let sent = receiverManager.sent;
+    let requestId = 100;
+    let replies = 0;
+    let reply = null;
+    sent.splice(0);
+    mock.timers.enable({ apis: ['setTimeout', 'setInterval', 'Date'], now: Date.now() });
+    perCall(name, iterations, () => {
+        receiverManager.deliver('sender', { type: 'GET_STATUS', requestId: requestId++, options });
+        mock.timers.tick(1000);
+        replies += sent.length;
+        reply = sent.pop();
+        sent.splice(0);
+    });
+    mock.timers.reset();
+    if (replies != iterations * ROUNDS) {
+        throw new Error(`expected ${iterations * ROUNDS} replies, got ${replies}`);
+    }
+    return reply;
+}
+
+for (const size of [10, 1000, 10000]) {
+    const iterations = Math.max(20, 50000 / size);
+    let receiverManager = await loadQueue(size);
+    let reply = requestStatus(`${size} items, GET_STATUS`, receiverManager, iterations, 0);
+    requestStatus(`${size} items, small fields only`, receiverManager, iterations,
+        GetStatusOptions.NO_METADATA | GetStatusOptions.NO_QUEUE_ITEMS);
+
+    let status = reply.msg.status[0];
+    perCall(`${size} items, JSON.stringify`, iterations, i => JSON.stringify({
+        type: 'MEDIA_STATUS',
+        requestId: i,
+        status: [Object.assign({}, status)]
+    }));
+    console.log(`  (${reply.raw.length} bytes, ${status.items ? status.items.length : 'no'} queue items)`);
+}
@@ -0,0 +1,130 @@
+import test from 'node:test';
+import assert from 'node:assert';
+import { startServer, setOnline, waitFor } from './support/network.mjs';
+import ConfigLoader, { CACHE_KEY_PREFIX } from '../src/js/config/loader.js';
+
+const LOCAL = '/local/foo/config.json';
+const REMOTE = '/foo.jwpapp.com/config.json';
+
+// What the server answers per path: {delay, status, config, etag}.
+let routes = {};
+let server = await startServer((request, response) => {
+    let route = routes[request.url] || { status: 404 };
+    setTimeout(() => {
+        if (route.etag && request.headers['if-none-match'] === route.etag) {
+            response.writeHead(304);
+            response.end();
+            return;
+        }
+        let headers = { 'Content-Type': 'application/json' };
+        if (route.etag) {
+            headers.ETag = route.etag;
+        }
+        response.writeHead(route.status || 200, headers);
+        response.end(route.config ? JSON.stringify(route.config) : '');
+    }, route.delay || 0);
+});
+
+test.after(() => server.close());
+
+test.beforeEach(() => {
+    routes = {};
+    server.requests = [];
+    localStorage.clear();
+    setOnline(true);
+});
+
+function readCache() {
+    return JSON.parse(localStorage.getItem(CACHE_KEY_PREFIX + 'foo'));
+}
+
+test('uses the remote config when there is no local one, and caches it', async () => {
+    routes[LOCAL] = { status: 404, delay: 40 };
+    routes[REMOTE] = { config: { key: 'remote' }, etag: '"v1"', delay: 10 };
+
+    let config = await ConfigLoader.getConfig('foo');
+    assert.strictEqual(config.key, 'remote');
+    assert.deepStrictEqual(server.requests.map(request => request.url).sort(), [REMOTE, LOCAL].sort());
+
+    let cached = readCache();
+    assert.strictEqual(cached.config.key, 'remote');
+    assert.strictEqual(cached.etag, '"v1"');
+    assert.ok(cached.url.endsWith('foo.jwpapp.com/config.json'));
+});
+
+test('uses the first valid config without waiting for the other', async () => {
+    routes[LOCAL] = { config: { key: 'local' }, delay: 10 };
+    routes[REMOTE] = { config: { key: 'remote' }, delay: 300 };
+
+    let start = Date.now();
+    let config = await ConfigLoader.getConfig('foo');
+    assert.strictEqual(config.key, 'local');
+    assert.ok(Date.now() - start < 300);
+    assert.strictEqual(readCache().config.key, 'local');
+});
+
+test('skips invalid configs and fails when no candidate is valid', async () => {
+    routes[LOCAL] = { config: { theme: 'dark' } };
+    routes[REMOTE] = { config: { key: 'remote' }, delay: 20 };
+    assert.strictEqual((await ConfigLoader.getConfig('foo')).key, 'remote');
+
+    localStorage.clear();
+    routes[REMOTE] = { status: 500 };
+    await assert.rejects(ConfigLoader.getConfig('foo'));
+});
+
+test('starts from the cached config and revalidates it conditionally', async () => {
+    routes[REMOTE] = { config: { key: 'remote' }, etag: '"v1"' };
+    await ConfigLoader.getConfig('foo');
+    let cached = readCache();
+
+    // A slow server does not hold up the launch.
+    routes[REMOTE].delay = 200;
+    server.requests = [];
+    let start = Date.now();
+    let config = await ConfigLoader.getConfig('foo');
+    assert.strictEqual(config.key, 'remote');
+    assert.ok(Date.now() - start < 200);
+
+    await waitFor(() => server.requests.length == 1);
+    assert.strictEqual(server.requests[0].url, REMOTE);
+    assert.strictEqual(server.requests[0].headers['if-none-match'], '"v1"');
+
+    // 304 Not Modified leaves the cache entry as it was.
+    await new Promise(resolve => setTimeout(resolve, 250));
+    assert.deepStrictEqual(readCache(), cached);
+});
+
+test('caches a changed config for the next launch', async () => {
+    routes[REMOTE] = { config: { key: 'v1' }, etag: '"v1"' };
+    await ConfigLoader.getConfig('foo');
+
+    routes[REMOTE] = { config: { key: 'v2' }, etag: '"v2"' };
+    assert.strictEqual((await ConfigLoader.getConfig('foo')).key, 'v1');
+    await waitFor(() => readCache().etag == '"v2"');
+    assert.strictEqual((await ConfigLoader.getConfig('foo')).key, 'v2');
+});
+
+test('launches offline from the cached config only', async () => {
+    routes[REMOTE] = { config: { key: 'remote' } };
+    await ConfigLoader.getConfig('foo');
+
+    setOnline(false);
+    assert.strictEqual((await ConfigLoader.getConfig('foo')).key, 'remote');
+
+    localStorage.clear();
+    await assert.rejects(ConfigLoader.getConfig('foo'));
+});
+
+test('prefers a baked config over an older cached one, and refreshes it', async () => {
+    let baked = { config: { key: 'baked' }, time: Date.now() };
+    routes[REMOTE] = { config: { key: 'remote' }, delay: 50 };
+
+    assert.strictEqual((await ConfigLoader.getConfig('foo', baked)).key, 'baked');
+    await waitFor(() => localStorage.getItem(CACHE_KEY_PREFIX + 'foo'));
+
+    // The refreshed config is newer than the baked one.
+    assert.strictEqual((await ConfigLoader.getConfig('foo', baked)).key, 'remote');
+    assert.strictEqual((await ConfigLoader.getConfig('foo', { config: { key: 'rebuilt' }, time: Date.now() })).key,
+        'rebuilt');
+});
@@ -0,0 +1,110 @@
+import test from 'node:test';
+import assert from 'node:assert';
+import { players, createReceiverManager, createContainer, createItems, tick } from './support/receiver.mjs';
+import EventBus from '../src/js/events.js';
+import JWMediaManager from '../src/js/cast/mediamanager.js';
+import ListenerRegistry from '../src/js/utils/listenerregistry.js';
+
+test('removes the listeners it added, and only those', () => {
+    let player = jwplayer(createContainer());
+    let other = () => {};
+    player.on('time', other);
+
+    let listeners = new ListenerRegistry(player);
+    let calls = 0;
+    let onTime = () => calls++;
+    listeners.on('time', onTime);
+    listeners.on('meta time', () => {});
+    listeners.once('complete', () => calls++);
+    assert.strictEqual(listeners.size, 3);
+    assert.strictEqual(player.listenerCount('time'), 3);
+
+    player.trigger('complete');
+    assert.strictEqual(calls, 1);
+    assert.strictEqual(listeners.size, 2);
+
+    listeners.off('time', onTime);
+    assert.strictEqual(listeners.size, 1);
+    player.trigger('time');
+    assert.strictEqual(calls, 1);
+
+    listeners.removeAll();
+    assert.strictEqual(listeners.size, 0);
+    assert.strictEqual(player.listenerCount(), 1);
+    assert.strictEqual(player.handlers.time[0].fn, other);
+});
+
+// Triggers time events in five rounds of `count`, returns the listener
+// calls per event and the milliseconds per event of the fastest round,
+// which leaves out garbage collection pauses.
+function measureTimeEvents(player, count) {
+    let dispatches = player.dispatches;
+    let ms = Infinity;
+    for (let round = 0; round < 5; round++) {
+        let start = process.hrtime.bigint();
+        for (let i = 0; i < count; i++) {
+            player.trigger('time', { position: 1 + i * 50 / count, duration: 100 });
+        }
+        ms = Math.min(ms, Number(process.hrtime.bigint() - start) / 1e6 / count);
+    }
+    return {
+        dispatches: (player.dispatches - dispatches) / count / 5,
+        ms: ms
+    };
+}
+
+test('keeps the number of player listeners constant while a queue plays', async () => {
+    let receiverManager = createReceiverManager();
+    let log = console.log;
+    console.log = () => {};
+    try {
+        new JWMediaManager(receiverManager, createContainer(), new EventBus(), {}, {});
+        receiverManager.deliver('sender', {
+            type: 'QUEUE_LOAD',
+            requestId: 1,
+            items: createItems(200),
+            repeatMode: 'REPEAT_OFF'
+        });
+        await tick();
+        let player = players[players.length - 1];
+
+        let counts = null;
+        let first = null;
+        let last = null;
+        for (let item = 0; item < 199; item++) {
+            player.trigger('meta', { duration: 100 });
+            await tick();
+            player.trigger('firstFrame');
+            player.trigger('time', { position: 1, duration: 100 });
+            if (item == 0) {
+                first = measureTimeEvents(player, 200);
+            } else if (item == 198) {
+                last = measureTimeEvents(player, 200);
+            }
+
+            let current = {};
+            Object.keys(player.handlers).forEach(name => {
+                current[name] = player.listenerCount(name);
+            });
+            if (counts) {
+                assert.deepStrictEqual(current, counts, `listeners of item ${item}`);
+            } else {
+                counts = current;
+            }
+
+            player.trigger('complete');
+            await tick();
+            await tick();
+        }
+
+        // The cost of a player event does not grow with the items played.
+        assert.strictEqual(last.dispatches, first.dispatches);
+        assert.ok(last.ms <= first.ms * 3 + 0.02, `${last.ms}ms per time event, ${first.ms}ms at first`);
+
+        assert.strictEqual(players[players.length - 1], player);
+        assert.strictEqual(player.setups, 1);
+        assert.strictEqual(player.loads, 199);
+    } finally {
+        console.log = log;
+    }
+});
@@ -0,0 +1,155 @@
+import test from 'node:test';
+import assert from 'node:assert';
+import { players, createReceiverManager, createContainer, createItems, tick } from './support/receiver.mjs';
+import EventBus from '../src/js/events.js';
+import JWMediaManager from '../src/js/cast/mediamanager.js';
+
+// The manager logs its progress, which is of no use here.
+console.log = () => {};
+
+function createManager(config) {
+    let receiverManager = createReceiverManager();
+    new JWMediaManager(receiverManager, createContainer(), new EventBus(), {}, config || {});
+    return receiverManager;
+}
+
+// Loads a queue and waits until its first item has been loaded.
+async function loadQueue(receiverManager, count) {
+    receiverManager.deliver('s1', {
+        type: 'QUEUE_LOAD',
+        requestId: 1,
+        items: createItems(count),
+        repeatMode: 'REPEAT_OFF'
+    });
+    await tick();
+    let player = players[players.length - 1];
+    player.trigger('meta', { duration: 60 });
+    await tick();
+    await tick();
+    let mediaSessionId = statusMessages(receiverManager, 's1')[0].msg.status[0].mediaSessionId;
+    receiverManager.sent.splice(0);
+    return { player, mediaSessionId };
+}
+
+// Records the calls of the given player methods in `calls`.
+function recordCalls(player, methods) {
+    let calls = [];
+    methods.forEach(method => {
+        let original = player[method];
+        player[method] = function() {
+            calls.push(method);
+            return original.apply(this, arguments);
+        };
+    });
+    return calls;
+}
+
+function statusMessages(receiverManager, to) {
+    return receiverManager.sent.filter(message => message.to == to && message.msg.type == 'MEDIA_STATUS');
+}
+
+test('answers GET_STATUS while loading, and broadcasts the loaded status', async () => {
+    let receiverManager = createManager();
+    receiverManager.deliver('s1', { type: 'LOAD', requestId: 1, media: createItems(1)[0].media });
+    await tick();
+    receiverManager.deliver('s2', { type: 'GET_STATUS', requestId: 5 });
+    await tick();
+    assert.strictEqual(statusMessages(receiverManager, 's2').length, 1);
+    assert.strictEqual(statusMessages(receiverManager, 's2')[0].msg.requestId, 5);
+
+    players[players.length - 1].trigger('meta', { duration: 60 });
+    await tick();
+    let ack = statusMessages(receiverManager, 's1');
+    assert.strictEqual(ack.length, 1);
+    assert.strictEqual(ack[0].msg.requestId, 1);
+    let broadcasts = statusMessages(receiverManager, '*');
+    assert.strictEqual(broadcasts.length, 1);
+    assert.strictEqual(broadcasts[0].msg.requestId, 0);
+    assert.ok(broadcasts[0].msg.status[0].media);
+});
+
+test('keeps transport commands in order with item changes', async () => {
+    let receiverManager = createManager();
+    let { player, mediaSessionId } = await loadQueue(receiverManager, 3);
+    let calls = recordCalls(player, ['load', 'play', 'pause']);
+
+    receiverManager.deliver('s1', { type: 'QUEUE_UPDATE', requestId: 20, mediaSessionId, jump: 1 });
+    receiverManager.deliver('s1', { type: 'PAUSE', requestId: 21, mediaSessionId });
+    await tick();
+    player.trigger('meta', { duration: 60 });
+    await tick();
+
+    assert.deepStrictEqual(calls, ['load', 'play', 'pause']);
+    let acks = receiverManager.sent.filter(message => message.msg.requestId).map(message => message.msg.requestId);
+    assert.deepStrictEqual(acks, [20, 21]);
+});
+
+test('executes a retry of a request that has been dropped', async () => {
+    let receiverManager = createManager();
+    let { player, mediaSessionId } = await loadQueue(receiverManager, 2);
+    let calls = recordCalls(player, ['pause']);
+
+    receiverManager.deliver('s1', { type: 'PAUSE', requestId: 30, mediaSessionId: mediaSessionId + 1 });
+    await tick();
+    assert.deepStrictEqual(calls, []);
+
+    receiverManager.deliver('s1', { type: 'PAUSE', requestId: 30, mediaSessionId });
+    player.trigger('pause', { newstate: 'paused' });
+    await tick();
+    assert.deepStrictEqual(calls, ['pause']);
+    assert.ok(receiverManager.sent.every(message => message.msg.type == 'MEDIA_STATUS'));
+    assert.ok(receiverManager.sent.some(message => message.msg.requestId == 30));
+});
+
+test('lists the new order when the queue is reshuffled', async () => {
+    let receiverManager = createManager();
+    receiverManager.deliver('s1', {
+        type: 'QUEUE_LOAD',
+        requestId: 1,
+        items: createItems(5),
+        repeatMode: 'REPEAT_ALL_AND_SHUFFLE',
+        startIndex: 4
+    });
+    await tick();
+    let player = players[players.length - 1];
+    player.trigger('meta', { duration: 60 });
+    await tick();
+    receiverManager.sent.splice(0);
+
+    player.trigger('complete');
+    await tick();
+    let change = receiverManager.sent.find(message => message.msg.type == 'QUEUE_CHANGE');
+    assert.strictEqual(change.msg.changeType, 'UPDATE');
+    assert.deepStrictEqual(change.msg.itemIds.slice().sort(), [1, 2, 3, 4, 5]);
+    assert.strictEqual(player.playlist[0].file || player.playlist[0].sources[0].file,
+        `https://cdn.example.com/videos/${change.msg.itemIds[0] - 1}.m3u8`);
+});
+
+test('acknowledges requests to their own sender only', async () => {
+    let receiverManager = createManager();
+    let { player, mediaSessionId } = await loadQueue(receiverManager, 2);
+
+    receiverManager.deliver('s1', { type: 'SEEK', requestId: 10, mediaSessionId, currentTime: 5 });
+    receiverManager.deliver('s1', { type: 'SEEK', requestId: 11, mediaSessionId, currentTime: 10 });
+    receiverManager.deliver('s2', { type: 'SEEK', requestId: 10, mediaSessionId, currentTime: 15 });
+    // The first seek is in flight, the last one is queued behind it.
+    player.trigger('seeked');
+    player.trigger('seeked');
+    await tick();
+
+    let acks = to => statusMessages(receiverManager, to).map(message => [
+        message.msg.requestId,
+        message.msg.completedRequestIds
+    ]);
+    assert.deepStrictEqual(acks('s1'), [[11, [10, 11]]]);
+    assert.deepStrictEqual(acks('s2'), [[10, undefined]]);
+    assert.deepStrictEqual(acks('*'), [[0, undefined]]);
+});
+
+test('rejects a QUEUE_LOAD that starts past the end of its items', async () => {
+    let receiverManager = createManager();
+    receiverManager.deliver('s1', { type: 'QUEUE_LOAD', requestId: 40, items: createItems(2), startIndex: 2 });
+    await tick();
+    assert.deepStrictEqual(receiverManager.sent.map(message => [message.msg.type, message.msg.requestId]),
+        [['INVALID_REQUEST', 40]]);
+});
@@ -0,0 +1,83 @@
+import test from 'node:test';
+import assert from 'node:assert';
+import MediaQueue from '../src/js/cast/mediaqueue.js';
+
+// Small seeded generator so a failing sequence can be replayed.
+function random(seed) {
+    return () => {
+        seed = (seed * 1103515245 + 12345) % 2147483648;
+        return seed / 2147483648;
+    };
+}
+
+function idsOf(queue) {
+    return queue.toArray().map(item => item.itemId);
+}
+
+test('assigns item ids in order, starting from 1', () => {
+    let queue = new MediaQueue([{}, {}, {}]);
+    assert.deepStrictEqual(idsOf(queue), [1, 2, 3]);
+    assert.deepStrictEqual(queue.insert([{}, {}], 2), [4, 5]);
+    assert.deepStrictEqual(idsOf(queue), [1, 4, 5, 2, 3]);
+});
+
+test('looks items up by id and by index', () => {
+    let queue = new MediaQueue([{}, {}, {}]);
+    queue.reorder([3], 1);
+    assert.strictEqual(queue.indexOf(3), 0);
+    assert.strictEqual(queue.get(0).itemId, 3);
+    assert.strictEqual(queue.getById(2).itemId, 2);
+    assert.strictEqual(queue.indexOf(99), -1);
+    assert.ok(!queue.has(99));
+});
+
+test('matches an array model over random edits', () => {
+    const rand = random(4);
+    const pick = model => model.length ? model[Math.floor(rand() * model.length)] : 999;
+    const insertAt = (model, before) => {
+        let at = before === undefined ? -1 : model.indexOf(before);
+        return at < 0 ? model.length : at;
+    };
+    let queue = new MediaQueue([{}, {}, {}]);
+    let model = [1, 2, 3];
+
+    for (let step = 0; step < 5000; step++) {
+        let op = rand();
+        if (op < 0.35) {
+            let count = 1 + Math.floor(rand() * 4);
+            let before = rand() < 0.3 ? undefined : pick(model);
+            let ids = queue.insert(Array.from({ length: count }, () => ({})), before);
+            model.splice(insertAt(model, before), 0, ...ids);
+        } else if (op < 0.6) {
+            let ids = [pick(model), pick(model)];
+            queue.remove(ids);
+            model = model.filter(id => ids.indexOf(id) < 0);
+        } else if (op < 0.9) {
+            let ids = [pick(model), pick(model), pick(model)];
+            let before = rand() < 0.3 ? undefined : pick(model);
+            queue.reorder(ids, before);
+            let moved = ids.filter((id, i) => ids.indexOf(id) == i && model.indexOf(id) >= 0);
+            model = model.filter(id => moved.indexOf(id) < 0);
+            model.splice(insertAt(model, before), 0, ...moved);
+        } else if (op < 0.95) {
+            let item = queue.shift();
+            if (model.length) {
+                assert.strictEqual(item.itemId, model.shift());
+            }
+        } else {
+            queue.shuffle();
+            let shuffled = idsOf(queue);
+            assert.deepStrictEqual(shuffled.slice().sort((a, b) => a - b), model.slice().sort((a, b) => a - b));
+            model = shuffled;
+        }
+
+        assert.strictEqual(idsOf(queue).join(), model.join(), `step ${step}`);
+        assert.strictEqual(queue.length, model.length);
+        if (step % 100 == 0) {
+            model.forEach((id, index) => {
+                assert.strictEqual(queue.indexOf(id), index);
+                assert.strictEqual(queue.get(index).itemId, id);
+            });
+        }
+    }
+});
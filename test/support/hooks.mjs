@@ -0,0 +1,18 @@
+// Module hooks that let node load src/js as the bundler does: the sources
+// are ES modules imported without file extensions.
+const SOURCE = /\/src\/js\//;
+
+export function resolve(specifier, context, nextResolve) {
+    if (/^\.{1,2}\//.test(specifier) && !/\.m?js$/.test(specifier) &&
+        context.parentURL && SOURCE.test(context.parentURL)) {
+        specifier += '.js';
+    }
+    return nextResolve(specifier, context);
+}
+
+export function load(url, context, nextLoad) {
+    if (SOURCE.test(url)) {
+        return nextLoad(url, Object.assign({}, context, { format: 'module' }));
+    }
+    return nextLoad(url, context);
+}
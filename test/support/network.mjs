@@ -0,0 +1,111 @@
+// An XMLHttpRequest backed by node's http client, and a localStorage.
+// Requests go to a local server, which sees the original URL as
+// /<host>/<path>, relative URLs as /local/<path>.
+import http from 'node:http';
+
+let port = 0;
+let online = true;
+
+class FakeXMLHttpRequest {
+    open(method, url) {
+        let match = /^https?:\/\/([^/]+)\/(.*)$/.exec(url);
+        let path = match ? `${match[1]}/${match[2]}` : `local/${url.replace(/^\.\//, '')}`;
+        this.method = method;
+        this.url = `http://127.0.0.1:${port}/${path}`;
+        this.requestHeaders = {};
+        this.responseHeaders = {};
+    }
+
+    setRequestHeader(name, value) {
+        this.requestHeaders[name] = value;
+    }
+
+    getResponseHeader(name) {
+        let value = this.responseHeaders[name.toLowerCase()];
+        return value === undefined ? null : value;
+    }
+
+    send() {
+        if (!online) {
+            setTimeout(() => this.onerror(), 0);
+            return;
+        }
+        let request = http.request(this.url, { method: this.method, headers: this.requestHeaders }, response => {
+            let body = '';
+            response.on('data', data => (body += data));
+            response.on('end', () => {
+                this.status = response.statusCode;
+                this.statusText = response.statusMessage;
+                this.responseHeaders = response.headers;
+                if (this.responseType == 'json') {
+                    try {
+                        this.response = JSON.parse(body);
+                    } catch (err) {
+                        this.response = null;
+                    }
+                } else {
+                    this.response = body;
+                }
+                this.onload();
+            });
+        });
+        request.on('error', () => this.onerror());
+        request.end();
+    }
+}
+
+class FakeStorage {
+    constructor() {
+        this.items = new Map();
+    }
+
+    getItem(key) {
+        return this.items.has(key) ? this.items.get(key) : null;
+    }
+
+    setItem(key, value) {
+        this.items.set(key, String(value));
+    }
+
+    clear() {
+        this.items.clear();
+    }
+}
+
+globalThis.window = globalThis;
+globalThis.XMLHttpRequest = FakeXMLHttpRequest;
+globalThis.localStorage = new FakeStorage();
+
+/**
+ * Starts the server that answers the requests, with handler(request, response).
+ * Resolves with the server, which records the requests it has received in
+ * `requests` as {url, headers}.
+ */
+export function startServer(handler) {
+    let server = http.createServer((request, response) => {
+        server.requests.push({ url: request.url, headers: request.headers });
+        handler(request, response);
+    });
+    server.requests = [];
+    return new Promise(resolve => server.listen(0, '127.0.0.1', () => {
+        port = server.address().port;
+        resolve(server);
+    }));
+}
+
+/**
+ * Makes every request fail as if the network was down, or restores it.
+ */
+export function setOnline(value) {
+    online = value;
+}
+
+/**
+ * Resolves once condition() returns true.
+ */
+export function waitFor(condition) {
+    return new Promise(resolve => {
+        let check = () => (condition() ? resolve() : setTimeout(check, 5));
+        check();
+    });
+}
@@ -0,0 +1,239 @@
+// Stubs of the browser, cast and jwplayer globals the receiver modules use,
+// with a fake player that records its listeners and fake message buses.
+
+/**
+ * Every player that has been created, in order.
+ */
+export const players = [];
+
+class FakePlayer {
+    constructor(element) {
+        this.element = element;
+        this.handlers = {};
+        // The number of listener calls made by trigger().
+        this.dispatches = 0;
+        this.setups = 0;
+        this.loads = 0;
+        this.duration = 0;
+        this.playlist = null;
+        this.config = null;
+        players.push(this);
+    }
+
+    on(names, fn) {
+        names.split(' ').forEach(name => (this.handlers[name] = this.handlers[name] || []).push({ fn }));
+        return this;
+    }
+
+    once(names, fn) {
+        names.split(' ').forEach(name => (this.handlers[name] = this.handlers[name] || []).push({ fn, once: true }));
+        return this;
+    }
+
+    off(names, fn) {
+        if (!names) {
+            this.handlers = {};
+            return this;
+        }
+        names.split(' ').forEach(name => {
+            if (!fn) {
+                delete this.handlers[name];
+            } else if (this.handlers[name]) {
+                this.handlers[name] = this.handlers[name].filter(handler => handler.fn !== fn);
+            }
+        });
+        return this;
+    }
+
+    trigger(name, event) {
+        if (name == 'meta' && event && event.duration) {
+            this.duration = event.duration;
+        }
+        let handlers = (this.handlers[name] || []).slice();
+        this.dispatches += handlers.length;
+        this.handlers[name] = (this.handlers[name] || []).filter(handler => !handler.once);
+        handlers.forEach(handler => handler.fn(event || {}));
+    }
+
+    /**
+     * Returns the number of listeners, of one event or of all of them.
+     */
+    listenerCount(name) {
+        if (name) {
+            return (this.handlers[name] || []).length;
+        }
+        return Object.keys(this.handlers).reduce((count, key) => count + this.handlers[key].length, 0);
+    }
+
+    setup(config) {
+        this.setups++;
+        this.config = config;
+        this.playlist = config.playlist;
+        return this;
+    }
+
+    load(playlist) {
+        this.loads++;
+        this.playlist = playlist;
+    }
+
+    getDuration() { return this.duration; }
+    getConfig() { return this.config; }
+    getContainer() { return this.element; }
+    getPlaylist() { return this.playlist; }
+    getPlaylistIndex() { return 0; }
+    getCaptionsList() { return [{ id: 'off' }]; }
+    getCurrentCaptions() { return 0; }
+    getAudioTracks() { return undefined; }
+    getCurrentAudioTrack() { return -1; }
+    setCurrentCaptions() {}
+    setCurrentAudioTrack() {}
+    setVolume() {}
+    setMute() {}
+    play() {}
+    pause() {}
+    seek() {}
+    stop() {}
+    remove() {
+        this.handlers = {};
+    }
+}
+
+const playersByElement = new Map();
+globalThis.jwplayer = function(element) {
+    if (!playersByElement.has(element)) {
+        playersByElement.set(element, new FakePlayer(element));
+    }
+    return playersByElement.get(element);
+};
+globalThis.jwplayer.version = '8.1.3';
+globalThis.jwplayer.utils = {
+    seconds: time => time.split(':').reduce((seconds, part) => seconds * 60 + parseFloat(part), 0)
+};
+
+class SentMessage {
+    constructor(to, raw) {
+        this.to = to;
+        this.raw = raw;
+    }
+
+    // Parsed on first use, so that benchmarks do not pay for it.
+    get msg() {
+        if (!this.parsed) {
+            this.parsed = JSON.parse(this.raw);
+        }
+        return this.parsed;
+    }
+}
+
+/**
+ * Returns a receiver manager with its own message bus. Every message sent
+ * on the bus is recorded in `sent` as {to, msg, raw}, `to` is '*' for
+ * broadcasts. `deliver` passes a message from a sender to the receiver.
+ */
+export function createReceiverManager() {
+    let listeners = [];
+    let sent = [];
+    let bus = {
+        addEventListener: (name, fn) => listeners.push(fn),
+        broadcast: message => sent.push(new SentMessage('*', message)),
+        send: (senderId, message) => sent.push(new SentMessage(senderId, message))
+    };
+    return {
+        sent,
+        deliver: (senderId, data) => listeners.forEach(fn => fn({ senderId, data: JSON.stringify(data) })),
+        getCastMessageBus: () => bus,
+        getSenders: () => [],
+        start() {},
+        stop() {}
+    };
+}
+
+let instance = null;
+globalThis.cast = {
+    receiver: {
+        media: {
+            MEDIA_NAMESPACE: 'urn:x-cast:com.google.cast.media',
+            MediaStatus: function() {},
+            MediaInformation: function() {},
+            StreamType: { NONE: 'NONE' }
+        },
+        CastReceiverManager: {
+            getInstance: () => instance || (instance = createReceiverManager())
+        },
+        logger: { setLevelValue() {} },
+        LoggerLevel: {}
+    }
+};
+
+class FakeElement {
+    constructor() {
+        this.children = [];
+        this.style = {};
+        this.className = '';
+        this.classList = { add() {}, remove() {} };
+        this.parentNode = null;
+    }
+
+    appendChild(child) {
+        child.parentNode = this;
+        this.children.push(child);
+        return child;
+    }
+
+    insertBefore(child) {
+        return this.appendChild(child);
+    }
+
+    setAttribute() {}
+    addEventListener() {}
+    getElementsByClassName() { return [new FakeElement()]; }
+}
+
+globalThis.window = globalThis;
+globalThis.document = {
+    createElement: () => new FakeElement(),
+    getElementById: () => new FakeElement(),
+    getElementsByClassName: () => [],
+    addEventListener() {},
+    head: new FakeElement(),
+    readyState: 'complete'
+};
+globalThis.requestAnimationFrame = fn => setTimeout(fn, 16);
+globalThis.cancelAnimationFrame = id => clearTimeout(id);
+
+/**
+ * Returns a player container, attached to a parent as in index.html.
+ */
+export function createContainer() {
+    let parent = new FakeElement();
+    return parent.appendChild(new FakeElement());
+}
+
+/**
+ * Resolves after the pending tasks have run.
+ */
+export function tick() {
+    return new Promise(resolve => setTimeout(resolve, 0));
+}
+
+/**
+ * Returns `count` queue items, each with a title, a subtitle and an image.
+ */
+export function createItems(count) {
+    return Array.from({ length: count }, (_, i) => ({
+        autoplay: true,
+        media: {
+            contentId: `https://cdn.example.com/videos/${i}.m3u8`,
+            contentType: 'application/vnd.apple.mpegurl',
+            streamType: 'BUFFERED',
+            metadata: {
+                metadataType: 0,
+                title: `Episode ${i}`,
+                subtitle: `A rather long description of episode ${i}`,
+                images: [{ url: `https://cdn.example.com/thumbs/${i}.jpg` }]
+            },
+            customData: { mediaid: `media${i}` }
+        }
+    }));
+}